@@ -15,30 +15,40 @@ if len(searchPath) > 0:
 else:
     gdb.write('Couldn\'t find path to include libstd++ pretty printers\n')
 
+# Strings are computed on demand by calling into the inferior, see src/debugstring.h. This requires
+# a library built with TSYM_DEBUG_STRINGS (the default for non-release builds) and a running process,
+# i.e., it doesn't work when inspecting a core file.
+
+def debugString(function, address):
+    if address is None:
+        return '<no debug string: value without address>'
+
+    try:
+        result = gdb.parse_and_eval('%s((const void *) %d)' % (function, int(address)))
+        return result.string()
+    except gdb.error as error:
+        return '<no debug string: %s>' % error
+
 class NumberPrinter:
     def __init__(self, val):
         self.val = val
 
     def to_string(self):
-        prettyStr = self.val['prettyStr']
-        return prettyStr
+        return debugString('tsym_debugStringNumber', self.val.address)
 
 class BasePtrPrinter:
     def __init__(self, val):
         self.val = val
 
     def to_string(self):
-        rep = self.val['bp']
-        prettyStr = rep['prettyStr']
-        return prettyStr
+        return debugString('tsym_debugStringBase', self.val['bp'])
 
 class VarPrinter:
     def __init__(self, val):
         self.val = val
 
     def to_string(self):
-        prettyStr = self.val['rep']['bp']['prettyStr']
-        return prettyStr
+        return debugString('tsym_debugStringBase', self.val['rep']['bp'])
 
 def lookupVariations(base):
     base = 'tsym::' + base
@@ -6,7 +6,8 @@
 #include "symbolmap.h"
 #include "product.h"
 #include "cache.h"
-#include "printer.h"
+#include "context.h"
+#include "contextdata.h"
 #include "logging.h"
 
 tsym::Base::Base() :
@@ -199,7 +200,7 @@ tsym::BasePtr tsym::Base::normal() const
 
 tsym::BasePtr tsym::Base::normalViaCache() const
 {
-    static Cache<BasePtr, BasePtr> cache;
+    Cache<BasePtr, BasePtr>& cache(Context::current().data().normalCache);
     const BasePtr *cached(cache.retrieve(clone()));
     BasePtr result;
 
@@ -227,7 +228,7 @@ tsym::BasePtr tsym::Base::normalWithoutCache() const
 tsym::BasePtr tsym::Base::diff(const BasePtr& symbol) const
 {
     if (symbol->isSymbol())
-        return diffWrtSymbol(symbol);
+        return diffViaCache(symbol);
 
     TSYM_WARNING("Differentiation w.r.t. %s! Only Symbols work, return Undefined.",
             typeStr().c_str());
@@ -235,6 +236,28 @@ tsym::BasePtr tsym::Base::diff(const BasePtr& symbol) const
     return Undefined::create();
 }
 
+tsym::BasePtr tsym::Base::diffViaCache(const BasePtr& symbol) const
+    /* Derivatives w.r.t. temporary Symbols aren't cached, because evicting such a key could
+     * decrement the counter for temporary Symbols while others with a higher id are still in use.
+     * Leafs are cheaper to differentiate than to look up. */
+{
+    BoundedCache<BasePtrList, BasePtr>& cache(Context::current().data().diffCache);
+    const BasePtrList key(clone(), symbol);
+    const BasePtr *cached(nullptr);
+    BasePtr result;
+
+    if (ops.empty() || symbol->name().isNumericId())
+        return diffWrtSymbol(symbol);
+    else if ((cached = cache.retrieve(key)) != nullptr)
+        return *cached;
+
+    result = diffWrtSymbol(symbol);
+
+    cache.insert(key, result);
+
+    return result;
+}
+
 const tsym::BasePtrList& tsym::Base::operands() const
 {
     return ops;
@@ -247,17 +270,3 @@ bool tsym::Base::isEqualByTypeAndOperands(const BasePtr& other) const
     else
         return false;
 }
-
-void tsym::Base::setDebugString()
-{
-#ifdef TSYM_DEBUG_STRINGS
-    /* When this class is instantiated, the reference count is zero. Construction and
-     * destruction of a BasePtr will then delete the object, to circumvent this, we artificially
-     * increment the reference count temporarily here. */
-    ++refCount;
-
-    prettyStr = Printer(BasePtr(this)).getStr();
-
-    --refCount;
-#endif
-}
@@ -1,10 +1,12 @@
 #ifndef TSYM_BASE_H
 #define TSYM_BASE_H
 
+#include <atomic>
 #include "number.h"
 #include "baseptrlist.h"
 #include "fraction.h"
 #include "name.h"
+#include "debugstring.h"
 
 namespace tsym { class SymbolMap; }
 
@@ -26,6 +28,9 @@ namespace tsym {
          * information without using casts or other runtime informations. */
         public:
             friend class BasePtr;
+#ifdef TSYM_DEBUG_STRINGS
+            friend const char *::tsym_debugStringBase(const void *base);
+#endif
 
             virtual bool isEqualDifferentBase(const BasePtr& other) const = 0;
             virtual bool sameType(const BasePtr& other) const = 0;
@@ -86,20 +91,16 @@ namespace tsym {
             virtual ~Base();
 
             bool isEqualByTypeAndOperands(const BasePtr& other) const;
-            void setDebugString();
 
             const BasePtrList ops;
 
         private:
             BasePtr normalViaCache() const;
             BasePtr normalWithoutCache() const;
+            BasePtr diffViaCache(const BasePtr& symbol) const;
 
-            mutable unsigned refCount;
-#ifdef TSYM_DEBUG_STRINGS
-            /* A member to be accessed by a gdb pretty printing plugin. As the class is immutable,
-             * it has to be filled with content during initialization only. */
-            std::string prettyStr;
-#endif
+            /* Atomic, as expressions like Numeric::zero() are shared between threads: */
+            mutable std::atomic<unsigned> refCount;
     };
 }
 
@@ -4,7 +4,7 @@
 #include "baseptr.h"
 #include "symbolmap.h"
 #include "undefined.h"
-#include "printer.h"
+#include "bufferprinter.h"
 #include "logging.h"
 
 /* For use in the default constructor only. */
@@ -82,9 +82,8 @@ const tsym::BasePtr& tsym::BasePtr::operator = (BasePtr&& other)
 
 tsym::BasePtr::~BasePtr()
 {
-    --bp->refCount;
-
-    if (bp->refCount == 0)
+    /* Decrement and check in one step, another thread could release its reference in between: */
+    if (--bp->refCount == 0)
         delete bp;
 }
 
@@ -100,11 +99,13 @@ const tsym::Base& tsym::BasePtr::operator* () const
 
 std::ostream& tsym::operator << (std::ostream& stream, const BasePtr& ptr)
 {
-    Printer printer(ptr);
+    std::string str;
+    BufferPrinter printer(str);
 
-    printer.print(stream);
+    printer.print(ptr);
 
-    return stream;
+    /* Inserted as a whole, such that the width and fill settings of the stream apply: */
+    return stream << str;
 }
 
 size_t std::hash<tsym::BasePtr>::operator () (const tsym::BasePtr& ptr) const
@@ -1,11 +1,19 @@
 
+#include <algorithm>
+#include <vector>
 #include "baseptrlist.h"
 #include "numeric.h"
 #include "product.h"
 #include "sum.h"
 #include "printer.h"
 #include "cache.h"
+#include "context.h"
+#include "contextdata.h"
 #include "logging.h"
+#include "sparsepoly.h"
+#include "kronecker.h"
+#include "termcollector.h"
+#include "parallel.h"
 
 namespace tsym {
     namespace {
@@ -15,6 +23,68 @@ namespace tsym {
 
             return undefined;
         }
+
+        /* Number of pairwise products of the summands, from which on the expansion of two sums
+         * is tried as a multiplication of integer polynomials: */
+        const size_t kroneckerThreshold = 256;
+
+        bool multiplyPolynomials(const BasePtr& u, const BasePtr& v, BasePtr& result)
+        {
+            BasePtrList variables;
+            SparsePoly sparseU;
+            SparsePoly sparseV;
+            SparsePoly product;
+
+            if (u->operands().size()*v->operands().size() < kroneckerThreshold)
+                return false;
+
+            variables = SparsePoly::variables(BasePtrList(), u, v);
+
+            if (!SparsePoly::fromBasePtr(u, variables, sparseU) ||
+                    !SparsePoly::fromBasePtr(v, variables, sparseV) ||
+                    !kroneckerMultiply(sparseU, sparseV, product))
+                return false;
+
+            result = product.toBasePtr(variables);
+
+            return true;
+        }
+
+        void collectInParallel(const BasePtr& u, const BasePtr& v, unsigned nThreads,
+                TermCollector& collector)
+            /* The summands of the first factor are processed in chunks, the partial results of
+             * the threads are merged afterwards. */
+        {
+            const std::vector<BasePtr> summands(u->operands().begin(), u->operands().end());
+            const size_t chunkSize = std::max<size_t>(1, summands.size()/(8*nThreads));
+            const size_t nChunks = (summands.size() + chunkSize - 1)/chunkSize;
+            std::vector<TermCollector> partial(nThreads);
+
+            runInParallel(nChunks, nThreads, [&](size_t chunk, unsigned thread) {
+                    const size_t last = std::min((chunk + 1)*chunkSize, summands.size());
+
+                    for (size_t i = chunk*chunkSize; i < last; ++i)
+                        for (const auto& other : v->operands())
+                            partial[thread].add(Product::create(summands[i], other)->expand());
+                    });
+
+            for (const auto& threadCollector : partial)
+                collector.merge(threadCollector);
+        }
+
+        void collectProducts(const BasePtr& u, const BasePtr& v, TermCollector& collector)
+        {
+            const ContextData& settings(Context::current().data());
+            const size_t nProducts = u->operands().size()*v->operands().size();
+
+            if (settings.expansionThreads > 1 && nProducts >= settings.parallelExpansionThreshold)
+                collectInParallel(u, v, std::min<unsigned>(settings.expansionThreads,
+                            static_cast<unsigned>(u->operands().size())), collector);
+            else
+                for (const auto& item : u->operands())
+                    for (const auto& other : v->operands())
+                        collector.add(Product::create(item, other)->expand());
+        }
     }
 }
 
@@ -87,6 +157,11 @@ tsym::BasePtr tsym::BasePtrList::pop_back()
     return last;
 }
 
+void tsym::BasePtrList::insert(iterator pos, const BasePtr& ptr)
+{
+    list.insert(pos, ptr);
+}
+
 void tsym::BasePtrList::insert(iterator pos, const_iterator first, const_iterator last)
 {
     list.insert(pos, first, last);
@@ -287,7 +362,7 @@ unsigned tsym::BasePtrList::complexitySum() const
 
 tsym::BasePtr tsym::BasePtrList::expandAsProduct() const
 {
-    static Cache<BasePtrList, BasePtr> cache;
+    Cache<BasePtrList, BasePtr>& cache(Context::current().data().expandCache);
     const BasePtr *cached(cache.retrieve(*this));
     BasePtr expanded;
     BasePtrList sums;
@@ -327,10 +402,13 @@ void tsym::BasePtrList::defScalarAndSums(BasePtr& scalar, BasePtrList& sums) con
 
 tsym::BasePtr tsym::BasePtrList::expandProductOf(BasePtrList& sums) const
     /* Recursively expands a the sum terms of a product, e.g. (a + b)*(c + d) = a*c + a*d + b*c +
-     * b*d. */
+     * b*d, where the pairwise products of summands are collected before the simplification of the
+     * sum, possibly by several threads (see Context). Large polynomials with integer coefficients
+     * are multiplied by Kronecker substitution instead. */
 {
     const BasePtr first(sums.pop_front());
-    BasePtrList summands;
+    TermCollector collector;
+    BasePtr product;
     BasePtr second;
 
     if (sums.empty())
@@ -338,25 +416,24 @@ tsym::BasePtr tsym::BasePtrList::expandProductOf(BasePtrList& sums) const
 
     second = sums.pop_front();
 
-    for (const auto& item : first->operands())
-        summands.push_back(Product::create(item, second)->expand());
-
-    sums.push_front(Sum::create(summands));
+    if (multiplyPolynomials(first, second, product))
+        sums.push_front(product);
+    else {
+        collectProducts(first, second, collector);
+        sums.push_front(collector.sum());
+    }
 
     return expandProductOf(sums);
 }
 
 tsym::BasePtr tsym::BasePtrList::expandProductOf(const BasePtr& scalar, const BasePtr& sum) const
 {
-    BasePtrList summands;
-    BasePtr product;
+    TermCollector collector;
 
-    for (const auto& item : sum->operands()) {
-        product = Product::create(scalar, item);
-        summands.push_back(product->expand());
-    }
+    for (const auto& item : sum->operands())
+        collector.add(Product::create(scalar, item)->expand());
 
-    return Sum::create(summands);
+    return collector.sum();
 }
 
 tsym::BasePtrList tsym::BasePtrList::subst(const BasePtr& from, const BasePtr& to) const
@@ -36,6 +36,7 @@ namespace tsym {
             /* Pop elements and return that element. This differs from the standard list: */
             BasePtr pop_front();
             BasePtr pop_back();
+            void insert(iterator pos, const BasePtr& ptr);
             void insert(iterator pos, const_iterator first, const_iterator last);
             iterator erase(iterator& it);
 
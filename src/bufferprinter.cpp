@@ -0,0 +1,430 @@
+
+#include <cassert>
+#include <cstdio>
+#include <vector>
+#include "bufferprinter.h"
+#include "baseptr.h"
+#include "baseptrlist.h"
+#include "base.h"
+#include "numeric.h"
+#include "power.h"
+#include "product.h"
+#include "undefined.h"
+#include "var.h"
+#include "context.h"
+
+namespace tsym {
+    namespace {
+        class Traversal {
+            /* Explicit-stack version of the recursive printing procedure. Every handler writes the
+             * leading characters of its node immediately and pushes the remaining parts in reverse
+             * order onto the stack, such that they are popped in the correct order afterwards. */
+            public:
+                Traversal(std::string& out) :
+                    out(out),
+                    fractions(Context::current().fractionsEnabled()),
+                    utf8(Context::current().utf8Enabled())
+                {}
+
+                void push(const BasePtr& ptr)
+                {
+                    pushExpr(ptr);
+                }
+
+                /* Processes one item, returns false if there is nothing left to print: */
+                bool step()
+                {
+                    Item item;
+
+                    if (stack.empty())
+                        return false;
+
+                    item = std::move(stack.back());
+                    stack.pop_back();
+
+                    if (item.kind == Item::Kind::TEXT)
+                        out.append(item.text);
+                    else if (item.kind == Item::Kind::EXPR)
+                        printExpr(item.expr);
+                    else
+                        printFactors(item.factors);
+
+                    return true;
+                }
+
+                void printNumber(const Number& n)
+                {
+                    if (n.isDouble())
+                        printDouble(n.toDouble());
+                    else if (n.isUndefined())
+                        out.append("Undefined");
+                    else {
+                        n.numerator().appendTo(out);
+
+                        if (n.isFrac()) {
+                            out.push_back('/');
+                            n.denominator().appendTo(out);
+                        }
+                    }
+                }
+
+            private:
+                struct Item {
+                    enum class Kind { TEXT, EXPR, FACTORS };
+
+                    Kind kind;
+                    const char *text;
+                    BasePtr expr;
+                    BasePtrList factors;
+                };
+
+                void pushText(const char *text)
+                {
+                    stack.push_back(Item());
+                    stack.back().kind = Item::Kind::TEXT;
+                    stack.back().text = text;
+                }
+
+                void pushExpr(const BasePtr& ptr)
+                {
+                    stack.push_back(Item());
+                    stack.back().kind = Item::Kind::EXPR;
+                    stack.back().expr = ptr;
+                }
+
+                void pushInParentheses(const BasePtr& ptr)
+                {
+                    pushText(")");
+                    pushExpr(ptr);
+                    pushText("(");
+                }
+
+                void pushFactors(const BasePtrList& factors)
+                {
+                    stack.push_back(Item());
+                    stack.back().kind = Item::Kind::FACTORS;
+                    stack.back().factors = factors;
+                }
+
+                void printExpr(const BasePtr& ptr)
+                {
+                    if (ptr->isSymbol())
+                        printSymbol(ptr);
+                    else if (ptr->isNumeric())
+                        printNumber(ptr->numericEval());
+                    else if (ptr->isPower())
+                        printPower(ptr->base(), ptr->exp());
+                    else if (ptr->isSum())
+                        printSum(ptr);
+                    else if (ptr->isProduct())
+                        printProduct(ptr);
+                    else if (ptr->isFunction())
+                        printFunction(ptr);
+                    else if (ptr->isConstant())
+                        printName(ptr);
+                    else if (ptr->isUndefined())
+                        out.append("Undefined");
+                    else
+                        out.append("Unknown");
+                }
+
+                void printSymbol(const BasePtr& ptr)
+                {
+                    printName(ptr);
+
+                    if (ptr->isPositive() && utf8)
+                        out.append("\u208A");
+                }
+
+                void printName(const BasePtr& ptr)
+                {
+                    if (utf8)
+                        out.append(ptr->name().unicode());
+                    else
+                        out.append(ptr->name().plain());
+                }
+
+                void printDouble(double value)
+                    /* Same format as the default settings of an output stream: */
+                {
+                    char buffer[32];
+                    const int length = std::snprintf(buffer, sizeof(buffer), "%g", value);
+
+                    assert(length > 0 && static_cast<size_t>(length) < sizeof(buffer));
+
+                    out.append(buffer, static_cast<size_t>(length));
+                }
+
+                void printPower(const BasePtr& base, const BasePtr& exp)
+                {
+                    const BasePtr half(Numeric::create(1, 2));
+
+                    if (exp->isEqual(half)) {
+                        out.append("sqrt(");
+                        pushText(")");
+                        pushExpr(base);
+                    } else if (isNegativeNumeric(exp) && fractions) {
+                        out.append("1/");
+                        printPower(base, toggleSign(exp));
+                    } else {
+                        pushExponent(exp);
+                        pushBase(base);
+                    }
+                }
+
+                bool isNegativeNumeric(const BasePtr& ptr) const
+                {
+                    return ptr->isNumeric() && ptr->isNegative();
+                }
+
+                BasePtr toggleSign(const BasePtr& numeric) const
+                {
+                    assert(numeric->isNumeric());
+
+                    return Numeric::create(-numeric->numericEval());
+                }
+
+                void pushBase(const BasePtr& base)
+                {
+                    if (base->isSymbol() || base->isConstant() || base->isFunction() ||
+                            isPositiveInt(base))
+                        pushExpr(base);
+                    else
+                        pushInParentheses(base);
+                }
+
+                bool isPositiveInt(const BasePtr& ptr) const
+                {
+                    Number n;
+
+                    if (!ptr->isNumeric())
+                        return false;
+
+                    n = ptr->numericEval();
+
+                    return n.isInt() && n > 0;
+                }
+
+                void pushExponent(const BasePtr& exp)
+                {
+                    if (exp->isOne())
+                        return;
+
+                    if (needsExpParentheses(exp))
+                        pushInParentheses(exp);
+                    else
+                        pushExpr(exp);
+
+                    pushText("^");
+                }
+
+                bool needsExpParentheses(const BasePtr& ptr) const
+                {
+                    if (ptr->isSymbol() || ptr->isConstant() || ptr->isFunction())
+                        return false;
+                    else if (!ptr->isNumeric())
+                        return true;
+                    else
+                        return !isPositiveInt(ptr);
+                }
+
+                unsigned prec(const BasePtr& ptr) const
+                {
+                    if (ptr->isSum())
+                        return 1;
+                    else if (ptr->isProduct())
+                        return productPrec;
+                    else if (ptr->isPower())
+                        return 3;
+                    else
+                        return 4;
+                }
+
+                void printSum(const BasePtr& ptr)
+                {
+                    const BasePtrList& summands(ptr->operands());
+
+                    for (auto it = summands.rbegin(); it != --summands.rend(); ++it)
+                        if (isProductWithNegativeNumeric(*it)) {
+                            pushExpr(Product::minus(*it));
+                            pushText(" - ");
+                        } else {
+                            pushExpr(*it);
+                            pushText(" + ");
+                        }
+
+                    pushExpr(summands.front());
+                }
+
+                bool isProductWithNegativeNumeric(const BasePtr& ptr) const
+                {
+                    if (!ptr->isProduct())
+                        return false;
+
+                    const BasePtr& first(ptr->operands().front());
+
+                    return first->isNumeric() && first->isNegative();
+                }
+
+                void printProduct(const BasePtr& ptr)
+                {
+                    BasePtrList factors(ptr->operands());
+                    const BasePtr& f1(factors.front());
+
+                    if (f1->isNumeric() && f1->numericEval() == -1) {
+                        out.push_back('-');
+                        factors.pop_front();
+                    }
+
+                    if (fractions)
+                        pushProductFrac(factors);
+                    else
+                        pushFactors(factors);
+                }
+
+                void pushProductFrac(const BasePtrList& factors)
+                {
+                    const std::pair<BasePtrList, BasePtrList> frac(getProductFrac(factors));
+                    const BasePtrList& num(frac.first);
+                    const BasePtrList& denom(frac.second);
+
+                    if (denom.size() == 1 && prec(denom.front()) > productPrec)
+                        pushExpr(denom.front());
+                    else if (!denom.empty())
+                        pushInParentheses(Product::create(denom));
+
+                    if (!denom.empty())
+                        pushText("/");
+
+                    if (num.empty())
+                        pushText("1");
+                    else if (num.size() == 1 && prec(num.front()) < productPrec)
+                        pushInParentheses(num.front());
+                    else
+                        pushFactors(num);
+                }
+
+                std::pair<BasePtrList, BasePtrList> getProductFrac(const BasePtrList& origFactors)
+                {
+                    std::pair<BasePtrList, BasePtrList> frac;
+                    Number fracFactor;
+
+                    for (const auto& origFactor : origFactors)
+                        if (origFactor->isPower() && isNegativeNumeric(origFactor->exp()))
+                            frac.second.push_back(Power::create(origFactor->base(),
+                                        toggleSign(origFactor->exp())));
+                        else
+                            frac.first.push_back(origFactor);
+
+                    if (frac.first.empty() || frac.second.size() <= 1 ||
+                            !frac.first.front()->isNumeric())
+                        return frac;
+
+                    /* Move factors like 2/3 to numerator/denominator. */
+                    fracFactor = frac.first.pop_front()->numericEval();
+
+                    frac.first.push_front(Numeric::create(fracFactor.numerator()));
+                    frac.second.push_front(Numeric::create(fracFactor.denominator()));
+
+                    return frac;
+                }
+
+                void printFactors(const BasePtrList& factors)
+                {
+                    auto first = factors.begin();
+
+                    if ((*first)->isOne() && factors.size() > 1)
+                        ++first;
+                    else if ((*first)->isEqual(Numeric::mOne()) && factors.size() > 1) {
+                        out.push_back('-');
+                        ++first;
+                    }
+
+                    for (auto it = factors.rbegin(); it.base() != first; ++it) {
+                        if (it != factors.rbegin())
+                            pushText("*");
+
+                        if (prec(*it) < productPrec)
+                            pushInParentheses(*it);
+                        else
+                            pushExpr(*it);
+                    }
+                }
+
+                void printFunction(const BasePtr& ptr)
+                {
+                    const BasePtrList& args(ptr->operands());
+
+                    printName(ptr);
+                    out.push_back('(');
+                    pushText(")");
+
+                    for (auto it = args.rbegin(); it != args.rend(); ++it) {
+                        if (it != args.rbegin())
+                            pushText(", ");
+
+                        pushExpr(*it);
+                    }
+                }
+
+                static const unsigned productPrec = 2;
+                std::string& out;
+                const bool fractions;
+                const bool utf8;
+                std::vector<Item> stack;
+        };
+    }
+}
+
+tsym::BufferPrinter::BufferPrinter(std::string& dest) :
+    out(dest),
+    chunkSize(0)
+{}
+
+tsym::BufferPrinter::BufferPrinter(const Sink& sink, size_t chunkSize) :
+    out(buffer),
+    sink(sink),
+    chunkSize(chunkSize)
+{}
+
+void tsym::BufferPrinter::print(const Var& var)
+{
+    print(var.getBasePtr());
+}
+
+void tsym::BufferPrinter::print(const BasePtr& ptr)
+{
+    Traversal traversal(out);
+
+    traversal.push(ptr);
+
+    while (traversal.step())
+        flushIfFull();
+
+    flush();
+}
+
+void tsym::BufferPrinter::print(const Number& number)
+{
+    Traversal traversal(out);
+
+    traversal.printNumber(number);
+
+    flush();
+}
+
+void tsym::BufferPrinter::flushIfFull()
+{
+    if (sink && out.size() >= chunkSize)
+        flush();
+}
+
+void tsym::BufferPrinter::flush()
+{
+    if (!sink || out.empty())
+        return;
+
+    sink(out.data(), out.size());
+
+    out.clear();
+}
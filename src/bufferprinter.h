@@ -0,0 +1,51 @@
+#ifndef TSYM_BUFFERPRINTER_H
+#define TSYM_BUFFERPRINTER_H
+
+#include <string>
+#include <cstddef>
+#include <functional>
+
+namespace tsym {
+    class BasePtr;
+    class Number;
+    class Var;
+}
+
+namespace tsym {
+    class BufferPrinter {
+        /* Fast backend for the text form of expressions, identical to the output of the Printer
+         * class and with the same Context settings for fractions and UTF8 characters. Instead of
+         * an iostream, characters are appended to a std::string, and the expression tree is
+         * traversed with an explicit stack instead of recursion, such that deeply nested
+         * expressions are fine, too.
+         *
+         * Output can either be appended to a string passed in by the caller, which can be reused
+         * for many expressions, or it is passed in chunks of the given size to a sink function.
+         * The latter allows for streaming very large expressions without building the whole
+         * string first. Remaining characters are passed to the sink at the end of every print
+         * call. */
+        public:
+            typedef std::function<void(const char *data, size_t length)> Sink;
+
+            explicit BufferPrinter(std::string& dest);
+            explicit BufferPrinter(const Sink& sink, size_t chunkSize = 65536);
+            BufferPrinter(const BufferPrinter& other) = delete;
+            const BufferPrinter& operator = (const BufferPrinter& rhs) = delete;
+
+            void print(const Var& var);
+            /* To be used only internally: */
+            void print(const BasePtr& ptr);
+            void print(const Number& number);
+
+        private:
+            void flushIfFull();
+            void flush();
+
+            std::string buffer;
+            std::string& out;
+            const Sink sink;
+            const size_t chunkSize;
+    };
+}
+
+#endif
@@ -0,0 +1,245 @@
+
+#include <cstring>
+#include <limits>
+#include "bytecodecompiler.h"
+#include "base.h"
+#include "numeric.h"
+#include "power.h"
+#include "product.h"
+#include "logging.h"
+
+tsym::BytecodeCompiler::BytecodeCompiler(const std::vector<Var>& symbols) :
+    nArguments(symbols.size()),
+    valid(true)
+{
+    for (size_t i = 0; i < symbols.size(); ++i)
+        if (symbols[i].type() != Var::Type::SYMBOL)
+            TSYM_WARNING("Ignore argument ", symbols[i], ", which isn't a symbol");
+        else
+            arguments.insert({ symbols[i].getBasePtr(), static_cast<std::uint32_t>(i) });
+}
+
+std::uint32_t tsym::BytecodeCompiler::lower(const BasePtr& expr)
+{
+    const auto lookup = registers.find(expr);
+    std::uint32_t reg;
+
+    if (lookup != registers.end())
+        return lookup->second;
+
+    if (expr->isNumeric() || expr->isConstant())
+        reg = constant(expr->numericEval().toDouble());
+    else if (expr->isSymbol())
+        reg = symbol(expr);
+    else if (expr->isSum())
+        reg = sum(expr->operands());
+    else if (expr->isProduct())
+        reg = product(expr->operands());
+    else if (expr->isPower())
+        reg = power(expr->base(), expr->exp());
+    else if (expr->isFunction())
+        reg = function(expr);
+    else
+        reg = constant(std::numeric_limits<double>::quiet_NaN());
+
+    return registers[expr] = reg;
+}
+
+std::uint32_t tsym::BytecodeCompiler::constant(double value)
+{
+    std::uint64_t bits;
+
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const auto lookup = constantIndices.find(bits);
+
+    if (lookup != constantIndices.end())
+        return lookup->second;
+
+    constantValues.push_back(value);
+
+    return constantIndices[bits] = CONSTANT | static_cast<std::uint32_t>(constantValues.size() - 1);
+}
+
+std::uint32_t tsym::BytecodeCompiler::symbol(const BasePtr& symbol)
+{
+    const auto lookup = arguments.find(symbol);
+
+    if (lookup != arguments.end())
+        return lookup->second;
+
+    TSYM_ERROR("Symbol ", symbol, " isn't an argument of the compiled expression, it evaluates ",
+            "to NaN");
+
+    valid = false;
+
+    return constant(std::numeric_limits<double>::quiet_NaN());
+}
+
+std::uint32_t tsym::BytecodeCompiler::sum(const BasePtrList& summands)
+{
+    auto it = summands.begin();
+    std::uint32_t reg = lower(*it);
+
+    for (++it; it != summands.end(); ++it)
+        if (isProductWithNegativeNumeric(*it))
+            reg = emit(OpCode::SUB, reg, lower(Product::minus(*it)));
+        else
+            reg = emit(OpCode::ADD, reg, lower(*it));
+
+    return reg;
+}
+
+bool tsym::BytecodeCompiler::isProductWithNegativeNumeric(const BasePtr& ptr) const
+{
+    if (!ptr->isProduct())
+        return false;
+
+    const BasePtr& first(ptr->operands().front());
+
+    return first->isNumeric() && first->isNegative();
+}
+
+std::uint32_t tsym::BytecodeCompiler::product(const BasePtrList& factors)
+    /* Factors with negative numeric exponent are collected in a denominator, such that x*y^(-2)
+     * results in one division instead of a reciprocal. */
+{
+    BasePtrList numerator;
+    BasePtrList denominator;
+    bool negate = false;
+    std::uint32_t reg;
+
+    for (const auto& factor : factors)
+        if (factor->isNumeric() && factor->numericEval() == -1)
+            negate = true;
+        else if (factor->isPower() && isNegativeNumeric(factor->exp()))
+            denominator.push_back(Power::create(factor->base(),
+                        Numeric::create(-factor->exp()->numericEval())));
+        else
+            numerator.push_back(factor);
+
+    reg = numerator.empty() ? constant(1.0) : chain(OpCode::MUL, numerator);
+
+    if (!denominator.empty())
+        reg = emit(OpCode::DIV, reg, chain(OpCode::MUL, denominator));
+
+    return negate ? emit(OpCode::NEG, reg) : reg;
+}
+
+bool tsym::BytecodeCompiler::isNegativeNumeric(const BasePtr& ptr) const
+{
+    return ptr->isNumeric() && ptr->isNegative();
+}
+
+std::uint32_t tsym::BytecodeCompiler::chain(OpCode op, const BasePtrList& operands)
+{
+    auto it = operands.begin();
+    std::uint32_t reg = lower(*it);
+
+    for (++it; it != operands.end(); ++it)
+        reg = emit(op, reg, lower(*it));
+
+    return reg;
+}
+
+std::uint32_t tsym::BytecodeCompiler::power(const BasePtr& base, const BasePtr& exp)
+{
+    if (exp->isNumeric())
+        return numericPower(base, exp->numericEval());
+    else if (base->isConstant() && base->name().getName() == "e")
+        return emit(OpCode::EXP, lower(exp));
+    else
+        return emit(OpCode::POW, lower(base), lower(exp));
+}
+
+std::uint32_t tsym::BytecodeCompiler::numericPower(const BasePtr& base, const Number& exp)
+{
+    Instruction *instruction;
+
+    if (exp == Number(1, 2))
+        return emit(OpCode::SQRT, lower(base));
+    else if (exp == Number(-1, 2))
+        return emit(OpCode::DIV, constant(1.0), emit(OpCode::SQRT, lower(base)));
+    else if (!exp.isInt() || !exp.numerator().fitsIntoInt())
+        return emit(OpCode::POW, lower(base), constant(exp.toDouble()));
+
+    emit(OpCode::POWI, lower(base));
+
+    instruction = &program.back();
+    instruction->exponent = exp.numerator().toInt();
+
+    return instruction->dest;
+}
+
+std::uint32_t tsym::BytecodeCompiler::function(const BasePtr& function)
+{
+    static const std::unordered_map<std::string, OpCode> ops { { "sin", OpCode::SIN },
+        { "cos", OpCode::COS }, { "tan", OpCode::TAN }, { "asin", OpCode::ASIN },
+        { "acos", OpCode::ACOS }, { "atan", OpCode::ATAN }, { "atan2", OpCode::ATAN2 },
+        { "log", OpCode::LOG } };
+    const auto lookup = ops.find(function->name().getName());
+    const BasePtrList& args(function->operands());
+
+    if (lookup == ops.end()) {
+        TSYM_ERROR("Unknown function ", function, " can't be compiled, use NaN");
+        valid = false;
+        return constant(std::numeric_limits<double>::quiet_NaN());
+    } else if (lookup->second == OpCode::ATAN2)
+        return emit(OpCode::ATAN2, lower(args.front()), lower(args.back()));
+    else
+        return emit(lookup->second, lower(args.front()));
+}
+
+std::uint32_t tsym::BytecodeCompiler::emit(OpCode op, std::uint32_t lhs, std::uint32_t rhs)
+{
+    const std::uint32_t dest = TEMPORARY | static_cast<std::uint32_t>(program.size());
+
+    program.push_back({ op, dest, lhs, rhs, 0 });
+
+    return dest;
+}
+
+void tsym::BytecodeCompiler::relocate(std::vector<std::uint32_t>& roots)
+{
+    for (auto& instruction : program) {
+        instruction.dest = relocated(instruction.dest);
+        instruction.lhs = relocated(instruction.lhs);
+        instruction.rhs = relocated(instruction.rhs);
+    }
+
+    for (auto& root : roots)
+        root = relocated(root);
+}
+
+std::uint32_t tsym::BytecodeCompiler::relocated(std::uint32_t index) const
+{
+    const std::uint32_t offset = static_cast<std::uint32_t>(nArguments);
+    const std::uint32_t nConstants = static_cast<std::uint32_t>(constantValues.size());
+
+    if (index & TEMPORARY)
+        return (index & ~TEMPORARY) + offset + nConstants;
+    else if (index & CONSTANT)
+        return (index & ~CONSTANT) + offset;
+    else
+        return index;
+}
+
+size_t tsym::BytecodeCompiler::nArgs() const
+{
+    return nArguments;
+}
+
+const std::vector<double>& tsym::BytecodeCompiler::constants() const
+{
+    return constantValues;
+}
+
+const std::vector<tsym::BytecodeCompiler::Instruction>& tsym::BytecodeCompiler::instructions() const
+{
+    return program;
+}
+
+bool tsym::BytecodeCompiler::isValid() const
+{
+    return valid;
+}
@@ -0,0 +1,65 @@
+#ifndef TSYM_BYTECODECOMPILER_H
+#define TSYM_BYTECODECOMPILER_H
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "baseptr.h"
+#include "baseptrlist.h"
+#include "compiledvar.h"
+
+namespace tsym { class Number; }
+
+namespace tsym {
+    class BytecodeCompiler {
+        /* Translates expressions into the register-based instructions of CompiledVar in a
+         * depth-first pass. Identical subexpressions are lowered only once, also across different
+         * roots. During the translation, constants and instruction results are numbered in their
+         * own ranges (marked by the highest bits), as the number of constants isn't known before
+         * the end. The final register indices, with the layout described in CompiledVar, are set
+         * by the relocate method, which must be called once after all roots have been lowered. */
+        public:
+            typedef CompiledVar::OpCode OpCode;
+            typedef CompiledVar::Instruction Instruction;
+
+            explicit BytecodeCompiler(const std::vector<Var>& symbols);
+            BytecodeCompiler(const BytecodeCompiler& other) = delete;
+            const BytecodeCompiler& operator = (const BytecodeCompiler& rhs) = delete;
+
+            /* Returns the register holding the result: */
+            std::uint32_t lower(const BasePtr& expr);
+            void relocate(std::vector<std::uint32_t>& roots);
+
+            size_t nArgs() const;
+            const std::vector<double>& constants() const;
+            const std::vector<Instruction>& instructions() const;
+            /* False if the expression contains symbols that aren't arguments: */
+            bool isValid() const;
+
+        private:
+            std::uint32_t constant(double value);
+            std::uint32_t symbol(const BasePtr& symbol);
+            std::uint32_t sum(const BasePtrList& summands);
+            bool isProductWithNegativeNumeric(const BasePtr& ptr) const;
+            std::uint32_t product(const BasePtrList& factors);
+            bool isNegativeNumeric(const BasePtr& ptr) const;
+            std::uint32_t chain(OpCode op, const BasePtrList& operands);
+            std::uint32_t power(const BasePtr& base, const BasePtr& exp);
+            std::uint32_t numericPower(const BasePtr& base, const Number& exp);
+            std::uint32_t function(const BasePtr& function);
+            std::uint32_t emit(OpCode op, std::uint32_t lhs, std::uint32_t rhs = 0);
+            std::uint32_t relocated(std::uint32_t index) const;
+
+            static const std::uint32_t TEMPORARY = 1u << 31;
+            static const std::uint32_t CONSTANT = 1u << 30;
+            const size_t nArguments;
+            std::vector<double> constantValues;
+            std::vector<Instruction> program;
+            bool valid;
+            std::unordered_map<BasePtr, std::uint32_t> arguments;
+            std::unordered_map<BasePtr, std::uint32_t> registers;
+            std::unordered_map<std::uint64_t, std::uint32_t> constantIndices;
+    };
+}
+
+#endif
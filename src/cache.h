@@ -2,6 +2,8 @@
 #define TSYM_CACHE_H
 
 #include <unordered_map>
+#include <list>
+#include <utility>
 #include <string>
 #include "logging.h"
 
@@ -33,9 +35,115 @@ namespace tsym {
                 return rep;
             }
 
+            size_t size() const
+            {
+                return rep.size();
+            }
+
+            void clear()
+            {
+                /* Swapping with an empty map makes sure the buckets are deallocated, too. */
+                std::unordered_map<S, T>().swap(rep);
+            }
+
         private:
             std::unordered_map<S, T> rep;
     };
+
+    template<class S, class T> class BoundedCache {
+        /* Cache with a maximum number of entries, the least recently used one is evicted when a
+         * new entry would exceed the capacity. A capacity of zero disables the cache, i.e.,
+         * nothing is stored at all. Hits, misses and evictions are counted for the whole lifetime
+         * of an instance. */
+        public:
+            struct Stats {
+                unsigned long hits;
+                unsigned long misses;
+                unsigned long evictions;
+            };
+
+            BoundedCache() :
+                capacity(0),
+                stats{ 0, 0, 0 }
+            {};
+            BoundedCache(const BoundedCache& other) = delete;
+            const BoundedCache& operator = (const BoundedCache& rhs) = delete;
+
+            void insert(const S& key, const T& value)
+            {
+                const auto lookup = index.find(key);
+
+                if (capacity == 0)
+                    return;
+                else if (lookup != index.end()) {
+                    lookup->second->second = value;
+                    entries.splice(entries.begin(), entries, lookup->second);
+                    return;
+                } else if (entries.size() == capacity)
+                    evict();
+
+                entries.emplace_front(key, value);
+                index[key] = entries.begin();
+            }
+
+            const T *retrieve(const S& key)
+            {
+                const auto lookup = index.find(key);
+
+                if (lookup == index.end()) {
+                    ++stats.misses;
+                    return nullptr;
+                }
+
+                ++stats.hits;
+                entries.splice(entries.begin(), entries, lookup->second);
+
+                return &lookup->second->second;
+            }
+
+            void setCapacity(size_t newCapacity)
+            {
+                capacity = newCapacity;
+
+                while (entries.size() > capacity)
+                    evict();
+            }
+
+            size_t getCapacity() const
+            {
+                return capacity;
+            }
+
+            size_t size() const
+            {
+                return entries.size();
+            }
+
+            const Stats& getStats() const
+            {
+                return stats;
+            }
+
+            void clear()
+            {
+                std::unordered_map<S, typename std::list<std::pair<S, T>>::iterator>().swap(index);
+                entries.clear();
+            }
+
+        private:
+            void evict()
+            {
+                index.erase(entries.back().first);
+                entries.pop_back();
+                ++stats.evictions;
+            }
+
+            size_t capacity;
+            Stats stats;
+            /* Most recently used entries first: */
+            std::list<std::pair<S, T>> entries;
+            std::unordered_map<S, typename std::list<std::pair<S, T>>::iterator> index;
+    };
 }
 
 #endif
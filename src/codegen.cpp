@@ -0,0 +1,306 @@
+
+#include <cmath>
+#include <cstdio>
+#include "codegen.h"
+#include "bytecodecompiler.h"
+#include "baseptr.h"
+
+namespace tsym {
+    namespace {
+        class CodeGenerator {
+            /* Translates the instructions of the BytecodeCompiler into C++ statements. Results
+             * that are used once are inlined into the expression that uses them, all others are
+             * stored in temporaries. Every register carries its text together with the precedence
+             * of its outermost operation, such that parentheses are only added where necessary. */
+            public:
+                CodeGenerator(const std::vector<Var>& symbols, const std::vector<Var>& exprs) :
+                    compiler(symbols),
+                    needsCmath(false),
+                    needsLimits(false),
+                    nTemporaries(0)
+                {
+                    for (const auto& expr : exprs)
+                        roots.push_back(compiler.lower(expr.getBasePtr()));
+
+                    compiler.relocate(roots);
+
+                    countUses();
+                    initRegisters(symbols);
+
+                    for (const auto& instruction : compiler.instructions())
+                        translate(instruction);
+                }
+
+                std::string function(const std::string& signature,
+                        const std::vector<Var>& symbols, bool scalar) const
+                {
+                    std::string code;
+
+                    if (needsCmath)
+                        code.append("#include <cmath>\n");
+
+                    if (needsLimits)
+                        code.append("#include <limits>\n");
+
+                    if (needsCmath || needsLimits)
+                        code.push_back('\n');
+
+                    code.append(argumentComment(symbols));
+                    code.append(signature + "\n{\n");
+                    code.append(body);
+
+                    if (scalar)
+                        code.append("    return " + registers[roots.front()].text + ";\n");
+                    else
+                        for (size_t i = 0; i < roots.size(); ++i)
+                            code.append("    result[" + std::to_string(i) + "] = " +
+                                    registers[roots[i]].text + ";\n");
+
+                    code.append("}\n");
+
+                    return code;
+                }
+
+            private:
+                typedef BytecodeCompiler::OpCode OpCode;
+                typedef BytecodeCompiler::Instruction Instruction;
+
+                enum Precedence { SUM, PRODUCT, UNARY, ATOM };
+
+                struct Register {
+                    std::string text;
+                    Precedence prec;
+                };
+
+                void countUses()
+                {
+                    const size_t nRegisters = compiler.nArgs() + compiler.constants().size() +
+                        compiler.instructions().size();
+
+                    uses.resize(nRegisters, 0);
+
+                    for (const auto& instruction : compiler.instructions()) {
+                        ++uses[instruction.lhs];
+
+                        if (isBinary(instruction.op))
+                            ++uses[instruction.rhs];
+                    }
+
+                    for (const auto root : roots)
+                        ++uses[root];
+                }
+
+                bool isBinary(OpCode op) const
+                {
+                    return op == OpCode::ADD || op == OpCode::SUB || op == OpCode::MUL ||
+                        op == OpCode::DIV || op == OpCode::POW || op == OpCode::ATAN2;
+                }
+
+                void initRegisters(const std::vector<Var>& symbols)
+                {
+                    registers.resize(uses.size());
+
+                    for (size_t i = 0; i < symbols.size(); ++i)
+                        registers[i] = { "args[" + std::to_string(i) + "]", ATOM };
+
+                    for (size_t i = 0; i < compiler.constants().size(); ++i)
+                        registers[symbols.size() + i] = literal(compiler.constants()[i]);
+                }
+
+                Register literal(double value)
+                {
+                    char buffer[32];
+                    std::string text;
+
+                    if (std::isnan(value) || std::isinf(value)) {
+                        needsLimits = true;
+                        text = std::isnan(value) ? "std::numeric_limits<double>::quiet_NaN()" :
+                            "std::numeric_limits<double>::infinity()";
+                        return { value < 0 ? "-" + text : text, value < 0 ? UNARY : ATOM };
+                    }
+
+                    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+                    text = buffer;
+
+                    if (text.find_first_of(".e") == std::string::npos)
+                        text.append(".0");
+
+                    return { text, value < 0 ? UNARY : ATOM };
+                }
+
+                void translate(const Instruction& instruction)
+                {
+                    const Register& lhs(registers[instruction.lhs]);
+                    const Register& rhs(registers[instruction.rhs]);
+                    Register result;
+
+                    switch (instruction.op) {
+                        case OpCode::ADD:
+                            result = { lhs.text + " + " + wrap(rhs, PRODUCT), SUM }; break;
+                        case OpCode::SUB:
+                            result = { lhs.text + " - " + wrap(rhs, PRODUCT), SUM }; break;
+                        case OpCode::MUL:
+                            result = { wrap(lhs, PRODUCT) + "*" + wrap(rhs, ATOM), PRODUCT }; break;
+                        case OpCode::DIV:
+                            result = { wrap(lhs, PRODUCT) + "/" + wrap(rhs, ATOM), PRODUCT }; break;
+                        case OpCode::NEG:
+                            result = { "-" + wrap(lhs, ATOM), UNARY }; break;
+                        case OpCode::POWI:
+                            result = integerPower(instruction.lhs, instruction.exponent); break;
+                        case OpCode::POW: result = call("std::pow", lhs, &rhs); break;
+                        case OpCode::SQRT: result = call("std::sqrt", lhs); break;
+                        case OpCode::EXP: result = call("std::exp", lhs); break;
+                        case OpCode::LOG: result = call("std::log", lhs); break;
+                        case OpCode::SIN: result = call("std::sin", lhs); break;
+                        case OpCode::COS: result = call("std::cos", lhs); break;
+                        case OpCode::TAN: result = call("std::tan", lhs); break;
+                        case OpCode::ASIN: result = call("std::asin", lhs); break;
+                        case OpCode::ACOS: result = call("std::acos", lhs); break;
+                        case OpCode::ATAN: result = call("std::atan", lhs); break;
+                        case OpCode::ATAN2: result = call("std::atan2", lhs, &rhs); break;
+                    }
+
+                    if (uses[instruction.dest] > 1)
+                        result = { declare(result.text), ATOM };
+
+                    registers[instruction.dest] = result;
+                }
+
+                std::string wrap(const Register& reg, Precedence minPrec) const
+                {
+                    return reg.prec < minPrec ? "(" + reg.text + ")" : reg.text;
+                }
+
+                Register call(const std::string& name, const Register& arg,
+                        const Register *arg2 = nullptr)
+                {
+                    needsCmath = true;
+
+                    if (arg2 == nullptr)
+                        return { name + "(" + arg.text + ")", ATOM };
+                    else
+                        return { name + "(" + arg.text + ", " + arg2->text + ")", ATOM };
+                }
+
+                Register integerPower(std::uint32_t baseRegister, int exp)
+                    /* Small exponents are plain products, larger ones use temporaries for the
+                     * repeated squares of the base. */
+                {
+                    unsigned n = exp < 0 ? 0u - static_cast<unsigned>(exp) :
+                        static_cast<unsigned>(exp);
+                    std::string square(atomic(baseRegister));
+                    std::string product;
+
+                    if (n == 0)
+                        return { "1.0", ATOM };
+                    else if (n <= 4)
+                        for (unsigned i = 0; i < n; ++i)
+                            product.append(i == 0 ? square : "*" + square);
+                    else
+                        while (n != 0) {
+                            if (n & 1u)
+                                product.append(product.empty() ? square : "*" + square);
+
+                            n >>= 1;
+
+                            if (n != 0)
+                                square = declare(square + "*" + square);
+                        }
+
+                    if (exp > 0)
+                        return { product, product == square ? ATOM : PRODUCT };
+                    else if (product.find('*') == std::string::npos)
+                        return { "1.0/" + product, PRODUCT };
+                    else
+                        return { "1.0/(" + product + ")", PRODUCT };
+                }
+
+                std::string atomic(std::uint32_t index)
+                {
+                    Register& reg(registers[index]);
+
+                    if (reg.prec != ATOM)
+                        reg = { declare(reg.text), ATOM };
+
+                    return reg.text;
+                }
+
+                std::string declare(const std::string& text)
+                {
+                    const std::string name("t" + std::to_string(nTemporaries++));
+
+                    body.append("    const double " + name + " = " + text + ";\n");
+
+                    return name;
+                }
+
+                std::string argumentComment(const std::vector<Var>& symbols) const
+                {
+                    std::string comment("/* Arguments:");
+
+                    if (symbols.empty())
+                        return "";
+
+                    for (size_t i = 0; i < symbols.size(); ++i) {
+                        const std::string entry(" args[" + std::to_string(i) + "] = " +
+                                symbols[i].name() + (i + 1 == symbols.size() ? "." : ","));
+
+                        if (comment.size() - comment.rfind('\n') + entry.size() > 100)
+                            comment.append("\n *");
+
+                        comment.append(entry);
+                    }
+
+                    return comment + " */\n";
+                }
+
+                BytecodeCompiler compiler;
+                std::vector<std::uint32_t> roots;
+                std::vector<unsigned> uses;
+                std::vector<Register> registers;
+                std::string body;
+                bool needsCmath;
+                bool needsLimits;
+                unsigned nTemporaries;
+        };
+
+        std::string generateFunction(const std::string& name, const std::vector<Var>& exprs,
+                const std::vector<Var>& symbols, bool scalar)
+        {
+            const CodeGenerator generator(symbols, exprs);
+            const std::string signature(scalar ? "double " + name + "(const double *args)" :
+                    "void " + name + "(const double *args, double *result)");
+
+            return generator.function(signature, symbols, scalar);
+        }
+    }
+}
+
+std::string tsym::generateCode(const std::string& name, const Var& expr,
+        const std::vector<Var>& symbols)
+{
+    return generateFunction(name, { expr }, symbols, true);
+}
+
+std::string tsym::generateCode(const std::string& name, const Vector& vector,
+        const std::vector<Var>& symbols)
+{
+    std::vector<Var> entries;
+
+    for (size_t i = 0; i < vector.size(); ++i)
+        entries.push_back(vector(i));
+
+    return generateFunction(name, entries, symbols, false);
+}
+
+std::string tsym::generateCode(const std::string& name, const Matrix& matrix,
+        const std::vector<Var>& symbols)
+{
+    std::vector<Var> entries;
+
+    for (size_t i = 0; i < matrix.rowSize(); ++i)
+        for (size_t j = 0; j < matrix.colSize(); ++j)
+            entries.push_back(matrix(i, j));
+
+    return generateFunction(name, entries, symbols, false);
+}
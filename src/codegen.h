@@ -0,0 +1,32 @@
+#ifndef TSYM_CODEGEN_H
+#define TSYM_CODEGEN_H
+
+#include <string>
+#include <vector>
+#include "var.h"
+#include "vector.h"
+#include "matrix.h"
+
+namespace tsym {
+    /* Generation of standalone C++ functions in double precision. The given symbols are passed to
+     * the function as an array in the given order. A scalar expression results in
+     *
+     * double name(const double *args);
+     *
+     * while vectors and matrices are written into an output array (matrices in row-major order):
+     *
+     * void name(const double *args, double *result);
+     *
+     * Subexpressions that are used more than once are computed once and stored in temporaries,
+     * also across different entries of a vector or matrix. Integer powers are multiplication
+     * chains, only non-integer exponents result in calls to std::pow. Symbols that aren't in the
+     * list of arguments are reported as errors and replaced by NaN. */
+    std::string generateCode(const std::string& name, const Var& expr,
+            const std::vector<Var>& symbols);
+    std::string generateCode(const std::string& name, const Vector& vector,
+            const std::vector<Var>& symbols);
+    std::string generateCode(const std::string& name, const Matrix& matrix,
+            const std::vector<Var>& symbols);
+}
+
+#endif
@@ -0,0 +1,189 @@
+
+#include <unordered_map>
+#include "commonsubexpressions.h"
+#include "baseptr.h"
+#include "base.h"
+#include "sum.h"
+#include "product.h"
+#include "power.h"
+#include "trigonometric.h"
+#include "logarithm.h"
+#include "logging.h"
+
+namespace tsym {
+    namespace {
+        class Eliminator {
+            public:
+                Eliminator(const std::vector<Var>& exprs, const std::string& prefix,
+                        std::vector<CommonSubexpressions::Temporary>& tmps) :
+                    prefix(validPrefix(prefix)),
+                    nextIndex(1),
+                    tmps(tmps)
+                {
+                    for (const auto& expr : exprs) {
+                        countOccurrences(expr.getBasePtr());
+
+                        for (const auto& symbol : expr.collectSymbols())
+                            usedNames.push_back(symbol.name());
+                    }
+                }
+
+                BasePtr rewrite(const BasePtr& ptr)
+                    /* Bottom-up, such that the definition of a temporary refers to the temporaries
+                     * of its operands, which are hence created first. */
+                {
+                    const auto lookup = rewritten.find(ptr);
+                    BasePtrList operands;
+                    BasePtr result;
+
+                    if (lookup != rewritten.end())
+                        return lookup->second;
+                    else if (!isComposite(ptr))
+                        return ptr;
+
+                    for (const auto& operand : ptr->operands())
+                        operands.push_back(rewrite(operand));
+
+                    result = rebuild(ptr, operands);
+
+                    if (occurrences[ptr] > 1) {
+                        tmps.push_back({ nextSymbol(), Var(result) });
+                        result = tmps.back().symbol.getBasePtr();
+                    }
+
+                    return rewritten[ptr] = result;
+                }
+
+            private:
+                static std::string validPrefix(const std::string& prefix)
+                {
+                    if (Var(prefix.c_str()).type() == Var::Type::SYMBOL)
+                        return prefix;
+
+                    TSYM_ERROR("Invalid prefix '", prefix, "' for temporaries, use 'x' instead");
+
+                    return "x";
+                }
+
+                bool isComposite(const BasePtr& ptr) const
+                {
+                    return ptr->isSum() || ptr->isProduct() || ptr->isPower() || ptr->isFunction();
+                }
+
+                void countOccurrences(const BasePtr& ptr)
+                    /* Operands are only traversed at the first occurrence of an expression, such
+                     * that an expression shared by many parents is counted once per parent. */
+                {
+                    if (!isComposite(ptr) || ++occurrences[ptr] > 1)
+                        return;
+
+                    for (const auto& operand : ptr->operands())
+                        countOccurrences(operand);
+                }
+
+                BasePtr rebuild(const BasePtr& ptr, const BasePtrList& operands) const
+                {
+                    const std::string& name(ptr->name().getName());
+
+                    if (operands.isEqual(ptr->operands()))
+                        return ptr;
+                    else if (ptr->isSum())
+                        return Sum::create(operands);
+                    else if (ptr->isProduct())
+                        return Product::create(operands);
+                    else if (ptr->isPower())
+                        return Power::create(operands.front(), operands.back());
+                    else if (name == "log")
+                        return Logarithm::create(operands.front());
+                    else if (name == "atan2")
+                        return Trigonometric::createAtan2(operands.front(), operands.back());
+                    else
+                        return rebuildTrigonometric(ptr, operands.front());
+                }
+
+                BasePtr rebuildTrigonometric(const BasePtr& ptr, const BasePtr& arg) const
+                {
+                    const std::string& name(ptr->name().getName());
+
+                    if (name == "sin")
+                        return Trigonometric::createSin(arg);
+                    else if (name == "cos")
+                        return Trigonometric::createCos(arg);
+                    else if (name == "tan")
+                        return Trigonometric::createTan(arg);
+                    else if (name == "asin")
+                        return Trigonometric::createAsin(arg);
+                    else if (name == "acos")
+                        return Trigonometric::createAcos(arg);
+                    else if (name == "atan")
+                        return Trigonometric::createAtan(arg);
+
+                    TSYM_ERROR("Unknown function ", ptr, ", operands are left unchanged");
+
+                    return ptr;
+                }
+
+                Var nextSymbol()
+                {
+                    Var symbol;
+
+                    do
+                        symbol = Var((prefix + "_{" + std::to_string(nextIndex++) + "}").c_str());
+                    while (isUsed(symbol.name()));
+
+                    return symbol;
+                }
+
+                bool isUsed(const std::string& name) const
+                {
+                    for (const auto& used : usedNames)
+                        if (used == name)
+                            return true;
+
+                    return false;
+                }
+
+                const std::string prefix;
+                unsigned nextIndex;
+                std::vector<CommonSubexpressions::Temporary>& tmps;
+                std::vector<std::string> usedNames;
+                std::unordered_map<BasePtr, unsigned> occurrences;
+                std::unordered_map<BasePtr, BasePtr> rewritten;
+        };
+    }
+}
+
+tsym::CommonSubexpressions::CommonSubexpressions(const Var& expr, const std::string& prefix) :
+    CommonSubexpressions(std::vector<Var>{ expr }, prefix)
+{}
+
+tsym::CommonSubexpressions::CommonSubexpressions(const std::vector<Var>& exprs,
+        const std::string& prefix)
+{
+    Eliminator eliminator(exprs, prefix, tmps);
+
+    for (const auto& expr : exprs)
+        rewrittenRoots.push_back(Var(eliminator.rewrite(expr.getBasePtr())));
+}
+
+const std::vector<tsym::CommonSubexpressions::Temporary>& tsym::CommonSubexpressions::temporaries()
+    const
+{
+    return tmps;
+}
+
+const std::vector<tsym::Var>& tsym::CommonSubexpressions::roots() const
+{
+    return rewrittenRoots;
+}
+
+std::ostream& tsym::operator << (std::ostream& stream, const CommonSubexpressions& cse)
+{
+    for (const auto& tmp : cse.temporaries())
+        stream << tmp.symbol << " = " << tmp.expr << "\n";
+
+    for (const auto& root : cse.roots())
+        stream << root << "\n";
+
+    return stream;
+}
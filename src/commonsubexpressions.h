@@ -0,0 +1,41 @@
+#ifndef TSYM_COMMONSUBEXPRESSIONS_H
+#define TSYM_COMMONSUBEXPRESSIONS_H
+
+#include <vector>
+#include <string>
+#include "var.h"
+
+namespace tsym {
+    class CommonSubexpressions {
+        /* Common subexpression elimination for one or more expressions. Subexpressions that occur
+         * more than once, found by structural hashing, are replaced by new symbols. The result is
+         * the list of these temporaries with their defining expressions, in an order such that
+         * every definition only refers to preceding temporaries, and the rewritten roots.
+         * Substituting the temporaries back in reverse order gives the original expressions.
+         *
+         * Temporaries are named by the given prefix and a subscript counting from one, e.g. x_1,
+         * x_2 etc., skipping names that are already used by symbols of the input. Numbers,
+         * symbols and constants are never replaced. */
+        public:
+            struct Temporary {
+                Var symbol;
+                Var expr;
+            };
+
+            explicit CommonSubexpressions(const Var& expr, const std::string& prefix = "x");
+            explicit CommonSubexpressions(const std::vector<Var>& exprs,
+                    const std::string& prefix = "x");
+
+            const std::vector<Temporary>& temporaries() const;
+            const std::vector<Var>& roots() const;
+
+        private:
+            std::vector<Temporary> tmps;
+            std::vector<Var> rewrittenRoots;
+    };
+
+    /* Prints one line per temporary of the form 'x_1 = ...', followed by the roots: */
+    std::ostream& operator << (std::ostream& stream, const CommonSubexpressions& cse);
+}
+
+#endif
@@ -0,0 +1,215 @@
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "compiledvar.h"
+#include "bytecodecompiler.h"
+#include "lanes.h"
+
+namespace tsym {
+    namespace {
+        typedef CompiledVar::OpCode OpCode;
+        typedef CompiledVar::Instruction Instruction;
+
+        template<class T> T broadcast(double value);
+
+        template<> double broadcast<double>(double value)
+        {
+            return value;
+        }
+
+        template<> Lanes broadcast<Lanes>(double value)
+        {
+            Lanes result;
+
+            for (size_t i = 0; i < nLanes; ++i)
+                result[i] = value;
+
+            return result;
+        }
+
+        double apply(double (*fct)(double), double x)
+        {
+            return fct(x);
+        }
+
+        double apply(double (*fct)(double, double), double x, double y)
+        {
+            return fct(x, y);
+        }
+
+        double squareRoot(double x)
+        {
+            return std::sqrt(x);
+        }
+
+        Lanes squareRoot(const Lanes& x)
+        {
+            return tsym::sqrt(x);
+        }
+
+        Lanes apply(double (*fct)(double), const Lanes& x)
+            /* There are no vectorized versions of the remaining math functions in the standard
+             * library, they are called per lane. */
+        {
+            Lanes result;
+
+            for (size_t i = 0; i < nLanes; ++i)
+                result[i] = fct(x[i]);
+
+            return result;
+        }
+
+        Lanes apply(double (*fct)(double, double), const Lanes& x, const Lanes& y)
+        {
+            Lanes result;
+
+            for (size_t i = 0; i < nLanes; ++i)
+                result[i] = fct(x[i], y[i]);
+
+            return result;
+        }
+
+        template<class T> T powi(T base, int exp)
+            /* Exponentiation by squaring. */
+        {
+            unsigned n = exp < 0 ? 0u - static_cast<unsigned>(exp) : static_cast<unsigned>(exp);
+            T result = broadcast<T>(1.0);
+
+            while (n != 0) {
+                if (n & 1u)
+                    result = result*base;
+
+                base = base*base;
+                n >>= 1;
+            }
+
+            return exp < 0 ? broadcast<T>(1.0)/result : result;
+        }
+
+        template<class T> void execute(const std::vector<Instruction>& program, T *r)
+            /* Instantiated for plain doubles and for Lanes, which are processed with SIMD
+             * instructions for arithmetic operations, integer powers and square roots. */
+        {
+            for (const auto& i : program)
+                switch (i.op) {
+                    case OpCode::ADD: r[i.dest] = r[i.lhs] + r[i.rhs]; break;
+                    case OpCode::SUB: r[i.dest] = r[i.lhs] - r[i.rhs]; break;
+                    case OpCode::MUL: r[i.dest] = r[i.lhs]*r[i.rhs]; break;
+                    case OpCode::DIV: r[i.dest] = r[i.lhs]/r[i.rhs]; break;
+                    case OpCode::NEG: r[i.dest] = -r[i.lhs]; break;
+                    case OpCode::POWI: r[i.dest] = powi(r[i.lhs], i.exponent); break;
+                    case OpCode::POW: r[i.dest] = apply(std::pow, r[i.lhs], r[i.rhs]); break;
+                    case OpCode::SQRT: r[i.dest] = squareRoot(r[i.lhs]); break;
+                    case OpCode::EXP: r[i.dest] = apply(std::exp, r[i.lhs]); break;
+                    case OpCode::LOG: r[i.dest] = apply(std::log, r[i.lhs]); break;
+                    case OpCode::SIN: r[i.dest] = apply(std::sin, r[i.lhs]); break;
+                    case OpCode::COS: r[i.dest] = apply(std::cos, r[i.lhs]); break;
+                    case OpCode::TAN: r[i.dest] = apply(std::tan, r[i.lhs]); break;
+                    case OpCode::ASIN: r[i.dest] = apply(std::asin, r[i.lhs]); break;
+                    case OpCode::ACOS: r[i.dest] = apply(std::acos, r[i.lhs]); break;
+                    case OpCode::ATAN: r[i.dest] = apply(std::atan, r[i.lhs]); break;
+                    case OpCode::ATAN2: r[i.dest] = apply(std::atan2, r[i.lhs], r[i.rhs]); break;
+                }
+        }
+    }
+}
+
+tsym::CompiledVar::CompiledVar() :
+    nArguments(0),
+    constantValues(1, std::numeric_limits<double>::quiet_NaN()),
+    result(0),
+    registerCount(1),
+    valid(true),
+    workspace(1),
+    batchWorkspace(nLanes)
+{}
+
+double tsym::CompiledVar::evaluate(const double *args) const
+{
+    return evaluate(args, workspace.data());
+}
+
+double tsym::CompiledVar::evaluate(const double *args, double *registers) const
+{
+    std::copy(args, args + nArguments, registers);
+    std::copy(constantValues.begin(), constantValues.end(), registers + nArguments);
+
+    execute(program, registers);
+
+    return registers[result];
+}
+
+void tsym::CompiledVar::evaluateBatch(const double *const *args, size_t n, double *results) const
+    /* The last block is padded with copies of the last arguments, such that no lane computes
+     * with uninitialized values. */
+{
+    Lanes *r = reinterpret_cast<Lanes*>(batchWorkspace.data());
+
+    for (size_t i = 0; i < constantValues.size(); ++i)
+        r[nArguments + i] = broadcast<Lanes>(constantValues[i]);
+
+    for (size_t offset = 0; offset < n; offset += nLanes) {
+        const size_t count = std::min(nLanes, n - offset);
+
+        for (size_t i = 0; i < nArguments; ++i)
+            for (size_t j = 0; j < nLanes; ++j)
+                r[i][j] = args[i][offset + std::min(j, count - 1)];
+
+        execute(program, r);
+
+        for (size_t j = 0; j < count; ++j)
+            results[offset + j] = r[result][j];
+    }
+}
+
+bool tsym::CompiledVar::isValid() const
+{
+    return valid;
+}
+
+size_t tsym::CompiledVar::nArgs() const
+{
+    return nArguments;
+}
+
+size_t tsym::CompiledVar::nRegisters() const
+{
+    return registerCount;
+}
+
+const std::vector<tsym::CompiledVar::Instruction>& tsym::CompiledVar::instructions() const
+{
+    return program;
+}
+
+const std::vector<double>& tsym::CompiledVar::constants() const
+{
+    return constantValues;
+}
+
+std::uint32_t tsym::CompiledVar::resultRegister() const
+{
+    return result;
+}
+
+tsym::CompiledVar tsym::compile(const Var& expr, const std::vector<Var>& symbols)
+{
+    BytecodeCompiler compiler(symbols);
+    std::vector<std::uint32_t> roots(1, compiler.lower(expr.getBasePtr()));
+    CompiledVar compiled;
+
+    compiler.relocate(roots);
+
+    compiled.nArguments = symbols.size();
+    compiled.constantValues = compiler.constants();
+    compiled.program = compiler.instructions();
+    compiled.result = roots.front();
+    compiled.registerCount = compiled.nArguments + compiled.constantValues.size() +
+        compiled.program.size();
+    compiled.valid = compiler.isValid();
+    compiled.workspace.resize(compiled.registerCount);
+    compiled.batchWorkspace.resize(nLanes*compiled.registerCount);
+
+    return compiled;
+}
@@ -0,0 +1,71 @@
+#ifndef TSYM_COMPILEDVAR_H
+#define TSYM_COMPILEDVAR_H
+
+#include <vector>
+#include <cstdint>
+#include "var.h"
+
+namespace tsym {
+    class CompiledVar {
+        /* Expression lowered to a flat, register-based program in double precision for evaluating
+         * it at many different argument values. Instances are created by the compile function
+         * below, which takes the expression and the symbols that become the arguments of the
+         * program, in that order. Identical subexpressions are computed only once, and evaluation
+         * doesn't allocate any memory.
+         *
+         * The register file is laid out as the arguments, followed by numeric constants and the
+         * results of every instruction. Evaluation without passing in registers uses a workspace
+         * owned by this object, which must hence not be used by different threads at the same
+         * time; use copies or the overload with caller-provided registers instead. Symbols that
+         * are not given as arguments result in an error message and evaluate to NaN. */
+        public:
+            enum class OpCode : std::uint8_t { ADD, SUB, MUL, DIV, NEG, POWI, POW, SQRT, EXP, LOG,
+                SIN, COS, TAN, ASIN, ACOS, ATAN, ATAN2 };
+
+            struct Instruction {
+                OpCode op;
+                std::uint32_t dest;
+                std::uint32_t lhs;
+                /* Unused for unary operations: */
+                std::uint32_t rhs;
+                /* Only for POWI: */
+                int exponent;
+            };
+
+            /* Evaluates to NaN: */
+            CompiledVar();
+
+            double evaluate(const double *args) const;
+            /* The registers must be an array of at least nRegisters() elements: */
+            double evaluate(const double *args, double *registers) const;
+            /* Evaluates the expression for n sets of arguments in structure-of-arrays layout, i.e.,
+             * args[i][j] is the value of the i-th argument for results[j]. Blocks of arguments
+             * are processed with SIMD instructions where available. Uses the workspace of this
+             * object, too: */
+            void evaluateBatch(const double *const *args, size_t n, double *results) const;
+
+            /* False if the expression contains symbols that aren't arguments: */
+            bool isValid() const;
+            size_t nArgs() const;
+            size_t nRegisters() const;
+            const std::vector<Instruction>& instructions() const;
+            const std::vector<double>& constants() const;
+            std::uint32_t resultRegister() const;
+
+        private:
+            friend CompiledVar compile(const Var& expr, const std::vector<Var>& symbols);
+
+            size_t nArguments;
+            std::vector<double> constantValues;
+            std::vector<Instruction> program;
+            std::uint32_t result;
+            size_t registerCount;
+            bool valid;
+            mutable std::vector<double> workspace;
+            mutable std::vector<double> batchWorkspace;
+    };
+
+    CompiledVar compile(const Var& expr, const std::vector<Var>& symbols);
+}
+
+#endif
@@ -7,9 +7,7 @@
 tsym::Constant::Constant(Type type, const Name& name) :
     type(type),
     constantName(name)
-{
-    setDebugString();
-}
+{}
 
 tsym::BasePtr tsym::Constant::createPi()
 {
@@ -0,0 +1,285 @@
+
+#include <mutex>
+#include "context.h"
+#include "contextdata.h"
+
+namespace tsym {
+    namespace {
+        struct Defaults {
+            bool fractions;
+            bool utf8;
+            Int maxPrimeResolution;
+        };
+
+        std::mutex& defaultsMutex()
+        {
+            static std::mutex mutex;
+
+            return mutex;
+        }
+
+        Defaults& defaults()
+        {
+#ifdef TSYM_WITHOUT_UTF8
+            static Defaults settings{ true, false, Int(1000) };
+#else
+            static Defaults settings{ true, true, Int(1000) };
+#endif
+
+            return settings;
+        }
+
+        Context*& installed()
+        {
+            static thread_local Context *context = nullptr;
+
+            return context;
+        }
+
+        Context& threadDefault()
+        {
+            static thread_local Context context;
+
+            return context;
+        }
+    }
+}
+
+tsym::ContextData::ContextData() :
+    expansionThreads(1),
+    parallelExpansionThreshold(10000),
+    normalizationThreads(1),
+    parallelNormalizationThreshold(16),
+    parallelInverseThreshold(8),
+    zeroTestErrorBound(1e-12)
+{
+    std::lock_guard<std::mutex> lock(defaultsMutex());
+
+    fractions = defaults().fractions;
+    utf8 = defaults().utf8;
+    maxPrimeResolution = defaults().maxPrimeResolution;
+
+    diffCache.setCapacity(10000);
+}
+
+void tsym::ContextData::clearCaches()
+{
+    normalCache.clear();
+    expandCache.clear();
+    divideCache.clear();
+    gcdCache.clear();
+    parseCache.clear();
+    diffCache.clear();
+    symbolPool.clear();
+}
+
+void tsym::ContextData::adoptSettings(const ContextData& other)
+{
+    fractions = other.fractions;
+    utf8 = other.utf8;
+    maxPrimeResolution = other.maxPrimeResolution;
+    zeroTestErrorBound = other.zeroTestErrorBound;
+}
+
+void tsym::ContextData::setMaxPrimeResolution(const Int& max)
+{
+    maxPrimeResolution = max;
+
+    parseCache.clear();
+    diffCache.clear();
+}
+
+void tsym::ContextData::setDefaultFractions(bool fractions)
+{
+    std::lock_guard<std::mutex> lock(defaultsMutex());
+
+    defaults().fractions = fractions;
+}
+
+void tsym::ContextData::setDefaultUtf8(bool utf8)
+{
+    std::lock_guard<std::mutex> lock(defaultsMutex());
+
+    defaults().utf8 = utf8;
+}
+
+void tsym::ContextData::setDefaultMaxPrimeResolution(const Int& max)
+{
+    std::lock_guard<std::mutex> lock(defaultsMutex());
+
+    defaults().maxPrimeResolution = max;
+}
+
+tsym::Context::Context() :
+    rep(new ContextData())
+{}
+
+tsym::Context::~Context()
+{
+    if (installed() == this)
+        installed() = nullptr;
+
+    delete rep;
+}
+
+tsym::Context& tsym::Context::current()
+{
+    Context *context = installed();
+
+    return context == nullptr ? threadDefault() : *context;
+}
+
+tsym::Context *tsym::Context::install(Context *context)
+{
+    Context *previous = installed();
+
+    installed() = context;
+
+    return previous;
+}
+
+void tsym::Context::enableFractions()
+{
+    rep->fractions = true;
+}
+
+void tsym::Context::disableFractions()
+{
+    rep->fractions = false;
+}
+
+bool tsym::Context::fractionsEnabled() const
+{
+    return rep->fractions;
+}
+
+void tsym::Context::enableUtf8()
+{
+    rep->utf8 = true;
+}
+
+void tsym::Context::disableUtf8()
+{
+    rep->utf8 = false;
+}
+
+bool tsym::Context::utf8Enabled() const
+{
+    return rep->utf8;
+}
+
+void tsym::Context::setMaxPrimeResolution(int max)
+{
+    rep->setMaxPrimeResolution(Int(max));
+}
+
+void tsym::Context::setExpansionThreads(unsigned nThreads)
+{
+    rep->expansionThreads = nThreads == 0 ? 1 : nThreads;
+}
+
+unsigned tsym::Context::expansionThreads() const
+{
+    return rep->expansionThreads;
+}
+
+void tsym::Context::setParallelExpansionThreshold(size_t nProducts)
+{
+    rep->parallelExpansionThreshold = nProducts;
+}
+
+size_t tsym::Context::parallelExpansionThreshold() const
+{
+    return rep->parallelExpansionThreshold;
+}
+
+void tsym::Context::setNormalizationThreads(unsigned nThreads)
+{
+    rep->normalizationThreads = nThreads == 0 ? 1 : nThreads;
+}
+
+unsigned tsym::Context::normalizationThreads() const
+{
+    return rep->normalizationThreads;
+}
+
+void tsym::Context::setParallelNormalizationThreshold(size_t nOperands)
+{
+    rep->parallelNormalizationThreshold = nOperands;
+}
+
+size_t tsym::Context::parallelNormalizationThreshold() const
+{
+    return rep->parallelNormalizationThreshold;
+}
+
+void tsym::Context::setParallelInverseThreshold(size_t nRows)
+{
+    rep->parallelInverseThreshold = nRows;
+}
+
+size_t tsym::Context::parallelInverseThreshold() const
+{
+    return rep->parallelInverseThreshold;
+}
+
+void tsym::Context::setZeroTestErrorBound(double bound)
+{
+    rep->zeroTestErrorBound = bound;
+}
+
+double tsym::Context::zeroTestErrorBound() const
+{
+    return rep->zeroTestErrorBound;
+}
+
+void tsym::Context::setZeroTestSeed(unsigned long seed)
+{
+    rep->zeroTestGenerator.seed(seed);
+}
+
+void tsym::Context::clear()
+{
+    rep->clearCaches();
+}
+
+void tsym::Context::setParseCacheCapacity(size_t capacity)
+{
+    rep->parseCache.setCapacity(capacity);
+}
+
+tsym::Context::CacheStats tsym::Context::parseCacheStats() const
+{
+    const auto& stats(rep->parseCache.getStats());
+
+    return { stats.hits, stats.misses, stats.evictions, rep->parseCache.size(),
+        rep->parseCache.getCapacity() };
+}
+
+void tsym::Context::clearParseCache()
+{
+    rep->parseCache.clear();
+}
+
+void tsym::Context::setDiffCacheCapacity(size_t capacity)
+{
+    rep->diffCache.setCapacity(capacity);
+}
+
+tsym::Context::CacheStats tsym::Context::diffCacheStats() const
+{
+    const auto& stats(rep->diffCache.getStats());
+
+    return { stats.hits, stats.misses, stats.evictions, rep->diffCache.size(),
+        rep->diffCache.getCapacity() };
+}
+
+void tsym::Context::clearDiffCache()
+{
+    rep->diffCache.clear();
+}
+
+tsym::ContextData& tsym::Context::data()
+{
+    return *rep;
+}
@@ -0,0 +1,103 @@
+#ifndef TSYM_CONTEXT_H
+#define TSYM_CONTEXT_H
+
+#include <cstddef>
+
+namespace tsym { class ContextData; }
+
+namespace tsym {
+    class Context {
+        /* Owner of the state that would otherwise be global to the library: printing and numeric
+         * power simplification settings, the caches for normalization, expansion, polynomial
+         * division, gcd computation, differentiation and parsing, the pool of Symbols and the
+         * counter for temporary Symbols.
+         *
+         * Every thread has a default instance that is used until another one is installed for this
+         * thread. An installed context is current for the calling thread only, such that isolated
+         * workloads with different settings can run side by side. Destroying a context releases
+         * everything it has cached at once; expressions still referenced elsewhere stay valid, as
+         * they are reference counted. A context must not be destroyed while it is installed in a
+         * thread other than the calling one. */
+        public:
+            struct CacheStats {
+                unsigned long hits;
+                unsigned long misses;
+                unsigned long evictions;
+                size_t size;
+                size_t capacity;
+            };
+            typedef CacheStats ParseCacheStats;
+
+            Context();
+            Context(const Context& other) = delete;
+            const Context& operator = (const Context& rhs) = delete;
+            ~Context();
+
+            /* Returns the context installed for the calling thread or its default one: */
+            static Context& current();
+            /* Installs the given context for the calling thread and returns the previously
+             * installed one. Passing a null pointer re-installs the thread's default context, and
+             * the same is true for the return value, if no context was installed before: */
+            static Context *install(Context *context);
+
+            void enableFractions();
+            void disableFractions();
+            bool fractionsEnabled() const;
+            void enableUtf8();
+            void disableUtf8();
+            bool utf8Enabled() const;
+            /* Upper bound for the prime factorization of numeric powers, default is 1000: */
+            void setMaxPrimeResolution(int max);
+            /* The expansion of a product of two sums with at least the given number of pairwise
+             * products of summands is distributed onto the given number of threads, each of them
+             * with its own context adopting the settings of this one. Defaults are one thread,
+             * i.e., sequential expansion, and 10000 products: */
+            void setExpansionThreads(unsigned nThreads);
+            unsigned expansionThreads() const;
+            void setParallelExpansionThreshold(size_t nProducts);
+            size_t parallelExpansionThreshold() const;
+            /* Likewise, sums with at least the given number of summands are normalized by
+             * processing the summands concurrently, and the fractions are brought to a common
+             * denominator pairwise in a tree. Defaults are one thread and 16 operands: */
+            void setNormalizationThreads(unsigned nThreads);
+            unsigned normalizationThreads() const;
+            void setParallelNormalizationThreshold(size_t nOperands);
+            size_t parallelNormalizationThreshold() const;
+            /* The columns of the inverse of a matrix with at least the given number of rows are
+             * computed concurrently by the number of normalization threads, default is 8 rows: */
+            void setParallelInverseThreshold(size_t nRows);
+            size_t parallelInverseThreshold() const;
+            /* Upper bound of the probability that Var::isZeroProbabilistic and the normalization
+             * of sums mistake a non-zero expression for zero, default is 1e-12: */
+            void setZeroTestErrorBound(double bound);
+            double zeroTestErrorBound() const;
+            /* The random points of these zero tests are drawn from one generator per context, which
+             * is seeded with a fixed default, such that results are reproducible. This restarts
+             * the sequence with the given seed: */
+            void setZeroTestSeed(unsigned long seed);
+            /* Drops all cached expressions and pooled Symbols, settings are kept: */
+            void clear();
+            /* Strings successfully parsed by tsym::parse or StringToVar are cached up to the given
+             * number of entries, the least recently used one is dropped first. Zero disables the
+             * cache, which is the default: */
+            void setParseCacheCapacity(size_t capacity);
+            CacheStats parseCacheStats() const;
+            /* Drops all parsed expressions, statistics are kept. This happens automatically when
+             * a setting changes that influences the simplification of parsed expressions: */
+            void clearParseCache();
+            /* Derivatives of composite expressions are cached up to the given number of entries,
+             * too, such that repeated and nested differentiation reuses earlier results. The
+             * default capacity is 10000, zero disables the cache: */
+            void setDiffCacheCapacity(size_t capacity);
+            CacheStats diffCacheStats() const;
+            void clearDiffCache();
+
+            /* To be used only internally: */
+            ContextData& data();
+
+        private:
+            ContextData *rep;
+    };
+}
+
+#endif
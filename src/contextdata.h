@@ -0,0 +1,55 @@
+#ifndef TSYM_CONTEXTDATA_H
+#define TSYM_CONTEXTDATA_H
+
+#include <random>
+#include <string>
+#include "baseptr.h"
+#include "baseptrlist.h"
+#include "cache.h"
+#include "int.h"
+
+namespace tsym {
+    class ContextData {
+        /* Internal part of a Context, accessed by the classes that formerly used static variables
+         * for settings, caches or pools. Members are public, the Context class takes care of
+         * installation and lifetime. */
+        public:
+            ContextData();
+
+            void clearCaches();
+            /* Takes over the settings that influence simplification, used for the contexts of
+             * worker threads: */
+            void adoptSettings(const ContextData& other);
+            /* Changes the automatic simplification of numeric powers, thus drops the cached parse
+             * results and derivatives, too: */
+            void setMaxPrimeResolution(const Int& max);
+
+            /* Process-wide defaults of the printing and simplification settings, which are copied
+             * by every new instance. These are changed by the static setters of the Printer and
+             * NumPowerSimpl class, such that settings made once at startup also apply to the
+             * contexts of threads started afterwards: */
+            static void setDefaultFractions(bool fractions);
+            static void setDefaultUtf8(bool utf8);
+            static void setDefaultMaxPrimeResolution(const Int& max);
+
+            bool fractions;
+            bool utf8;
+            Int maxPrimeResolution;
+            unsigned expansionThreads;
+            size_t parallelExpansionThreshold;
+            unsigned normalizationThreads;
+            size_t parallelNormalizationThreshold;
+            size_t parallelInverseThreshold;
+            double zeroTestErrorBound;
+            std::mt19937_64 zeroTestGenerator;
+            Cache<BasePtr, BasePtr> symbolPool;
+            Cache<BasePtr, BasePtr> normalCache;
+            Cache<BasePtrList, BasePtr> expandCache;
+            Cache<BasePtrList, BasePtrList> divideCache;
+            Cache<BasePtrList, BasePtr> gcdCache;
+            BoundedCache<std::string, BasePtr> parseCache;
+            BoundedCache<BasePtrList, BasePtr> diffCache;
+    };
+}
+
+#endif
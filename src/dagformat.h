@@ -0,0 +1,41 @@
+#ifndef TSYM_DAGFORMAT_H
+#define TSYM_DAGFORMAT_H
+
+#include <cstdint>
+
+namespace tsym {
+    namespace dagFormat {
+        /* Layout of the binary serialization of expressions written by DagWriter and read by
+         * DagReader. All integers are unsigned little-endian values of fixed width, such that the
+         * data can be read without alignment requirements directly from a memory-mapped file:
+         *
+         * - header: 8 byte magic, 4 byte version, 4 byte number of nodes
+         * - nodes: 1 byte tag followed by the tag-specific payload
+         * - roots: 4 byte number of roots, 4 byte node index per root
+         *
+         * Every node is stored once and referenced by its index in the node sequence. Operands are
+         * always written before the node they belong to, i.e., a node only refers to smaller
+         * indices. Payloads are:
+         *
+         * - INTEGER: 1 byte sign (1 for negative values), 4 byte number of words, the absolute
+         *   value as 8 byte words, least significant word first
+         * - FRACTION: numerator and denominator, each as INTEGER payload
+         * - DOUBLE: 8 byte IEEE 754 representation
+         * - SYMBOL, POSITIVE_SYMBOL: name, subscript and superscript as 4 byte length plus chars
+         * - SUM, PRODUCT: 4 byte number of operands plus their indices
+         * - POWER, ATAN2: two indices
+         * - remaining functions: one index, constants and UNDEFINED: no payload
+         *
+         * Sums, products and powers are stored in their simplified form, and they are restored
+         * as they are, without a second simplification. The version must be incremented whenever
+         * this layout or the order of operands of simplified expressions changes. */
+        const char magic[8] = { 't', 's', 'y', 'm', 'd', 'a', 'g', '\0' };
+        const std::uint32_t version = 1;
+        const std::uint32_t headerSize = 16;
+
+        enum Tag : std::uint8_t { UNDEFINED, INTEGER, FRACTION, DOUBLE, SYMBOL, POSITIVE_SYMBOL,
+            PI, EULER, SUM, PRODUCT, POWER, SIN, COS, TAN, ASIN, ACOS, ATAN, ATAN2, LOG };
+    }
+}
+
+#endif
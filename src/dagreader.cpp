@@ -0,0 +1,343 @@
+
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+#include "dagreader.h"
+#include "int.h"
+#include "numeric.h"
+#include "symbol.h"
+#include "constant.h"
+#include "undefined.h"
+#include "sum.h"
+#include "product.h"
+#include "power.h"
+#include "trigonometric.h"
+#include "logarithm.h"
+#include "logging.h"
+
+namespace tsym {
+    namespace {
+        Trigonometric::Type trigonometricType(dagFormat::Tag tag)
+        {
+            switch (tag) {
+                case dagFormat::SIN:
+                    return Trigonometric::Type::SIN;
+                case dagFormat::COS:
+                    return Trigonometric::Type::COS;
+                case dagFormat::TAN:
+                    return Trigonometric::Type::TAN;
+                case dagFormat::ASIN:
+                    return Trigonometric::Type::ASIN;
+                case dagFormat::ACOS:
+                    return Trigonometric::Type::ACOS;
+                default:
+                    assert(tag == dagFormat::ATAN);
+                    return Trigonometric::Type::ATAN;
+            }
+        }
+    }
+}
+
+tsym::DagReader::DagReader(const char *data, size_t length) :
+    pos(reinterpret_cast<const unsigned char*>(data)),
+    end(reinterpret_cast<const unsigned char*>(data) + length),
+    successful(false)
+{
+    successful = read();
+
+    if (!successful)
+        roots.clear();
+
+    nodes.clear();
+}
+
+bool tsym::DagReader::read()
+{
+    std::uint32_t nNodes;
+
+    if (!readHeader() || !readUint32(nNodes))
+        return false;
+
+    /* Every node takes at least one byte, which limits the reservation for corrupt input: */
+    nodes.reserve(std::min<size_t>(nNodes, static_cast<size_t>(end - pos)));
+
+    for (std::uint32_t i = 0; i < nNodes; ++i)
+        if (!readNode())
+            return false;
+
+    return readRoots();
+}
+
+bool tsym::DagReader::readHeader()
+{
+    std::uint32_t version;
+
+    if (static_cast<size_t>(end - pos) < dagFormat::headerSize)
+        return fail("Binary expression data is too short");
+    else if (std::memcmp(pos, dagFormat::magic, sizeof(dagFormat::magic)) != 0)
+        return fail("Binary expression data doesn't start with the expected magic bytes");
+
+    pos += sizeof(dagFormat::magic);
+
+    readUint32(version);
+
+    if (version != dagFormat::version)
+        return fail("Unsupported version " + std::to_string(version) +
+                " of binary expression data, expected " + std::to_string(dagFormat::version));
+
+    return true;
+}
+
+bool tsym::DagReader::readNode()
+{
+    std::uint8_t tag;
+
+    if (!readUint8(tag))
+        return false;
+
+    switch (tag) {
+        case dagFormat::UNDEFINED:
+            nodes.push_back(Undefined::create());
+            return true;
+        case dagFormat::INTEGER:
+        case dagFormat::FRACTION:
+        case dagFormat::DOUBLE:
+            return readNumber(static_cast<dagFormat::Tag>(tag));
+        case dagFormat::SYMBOL:
+        case dagFormat::POSITIVE_SYMBOL:
+            return readSymbol(tag == dagFormat::POSITIVE_SYMBOL);
+        case dagFormat::PI:
+            nodes.push_back(Constant::createPi());
+            return true;
+        case dagFormat::EULER:
+            nodes.push_back(Constant::createE());
+            return true;
+        case dagFormat::SUM:
+        case dagFormat::PRODUCT:
+        case dagFormat::POWER:
+            return readComposite(static_cast<dagFormat::Tag>(tag));
+        case dagFormat::SIN:
+        case dagFormat::COS:
+        case dagFormat::TAN:
+        case dagFormat::ASIN:
+        case dagFormat::ACOS:
+        case dagFormat::ATAN:
+        case dagFormat::ATAN2:
+        case dagFormat::LOG:
+            return readFunction(static_cast<dagFormat::Tag>(tag));
+        default:
+            return fail("Unknown node tag " + std::to_string(tag) + " in binary expression data");
+    }
+}
+
+bool tsym::DagReader::readNumber(dagFormat::Tag tag)
+{
+    std::uint64_t bits;
+    double value;
+    Int numerator;
+    Int denominator(1);
+
+    if (tag == dagFormat::DOUBLE) {
+        if (!readUint64(bits))
+            return false;
+
+        std::memcpy(&value, &bits, sizeof(value));
+        nodes.push_back(Numeric::create(value));
+
+        return true;
+    } else if (!readInt(numerator))
+        return false;
+    else if (tag == dagFormat::FRACTION && !readInt(denominator))
+        return false;
+    else if (denominator <= 0)
+        return fail("Non-positive denominator in binary expression data");
+
+    nodes.push_back(Numeric::create(numerator, denominator));
+
+    return true;
+}
+
+bool tsym::DagReader::readSymbol(bool positive)
+{
+    std::string name;
+    std::string subscript;
+    std::string superscript;
+
+    if (!readString(name) || !readString(subscript) || !readString(superscript))
+        return false;
+    else if (name.empty())
+        return fail("Empty symbol name in binary expression data");
+
+    const Name symbolName(name, subscript, superscript);
+
+    nodes.push_back(positive ? Symbol::createPositive(symbolName) : Symbol::create(symbolName));
+
+    return true;
+}
+
+bool tsym::DagReader::readComposite(dagFormat::Tag tag)
+{
+    std::uint32_t nOperands = 2;
+    BasePtrList operands;
+    BasePtr operand;
+
+    if (tag != dagFormat::POWER && !readUint32(nOperands))
+        return false;
+    else if (nOperands < 2)
+        return fail("Sum or product with less than two operands in binary expression data");
+
+    for (std::uint32_t i = 0; i < nOperands; ++i)
+        if (readIndex(operand))
+            operands.push_back(operand);
+        else
+            return false;
+
+    if (tag == dagFormat::SUM)
+        nodes.push_back(BasePtr(new Sum(operands)));
+    else if (tag == dagFormat::PRODUCT)
+        nodes.push_back(BasePtr(new Product(operands)));
+    else
+        nodes.push_back(BasePtr(new Power(operands.front(), operands.back())));
+
+    return true;
+}
+
+bool tsym::DagReader::readFunction(dagFormat::Tag tag)
+{
+    BasePtr arg1;
+    BasePtr arg2;
+
+    if (!readIndex(arg1) || (tag == dagFormat::ATAN2 && !readIndex(arg2)))
+        return false;
+
+    if (tag == dagFormat::LOG)
+        nodes.push_back(BasePtr(new Logarithm(arg1)));
+    else if (tag == dagFormat::ATAN2)
+        nodes.push_back(BasePtr(new Trigonometric(BasePtrList(arg1, arg2),
+                        Trigonometric::Type::ATAN2)));
+    else
+        nodes.push_back(BasePtr(new Trigonometric(BasePtrList(arg1), trigonometricType(tag))));
+
+    return true;
+}
+
+bool tsym::DagReader::readRoots()
+{
+    std::uint32_t nRoots;
+    BasePtr root;
+
+    if (!readUint32(nRoots))
+        return false;
+
+    for (std::uint32_t i = 0; i < nRoots; ++i)
+        if (readIndex(root))
+            roots.push_back(root);
+        else
+            return false;
+
+    if (pos != end)
+        return fail("Trailing bytes after binary expression data");
+
+    return true;
+}
+
+bool tsym::DagReader::readIndex(BasePtr& operand)
+    /* Only nodes that have already been read can be referenced, which rules out cycles. */
+{
+    std::uint32_t index;
+
+    if (!readUint32(index))
+        return false;
+    else if (index >= nodes.size())
+        return fail("Invalid node index " + std::to_string(index) + " in binary expression data");
+
+    operand = nodes[index];
+
+    return true;
+}
+
+bool tsym::DagReader::readInt(Int& n)
+{
+    std::uint8_t negative;
+    std::uint32_t nWords;
+
+    if (!readUint8(negative) || !readUint32(nWords))
+        return false;
+    else if (static_cast<size_t>(end - pos)/8 < nWords)
+        return fail("Integer exceeds binary expression data");
+
+    n = Int::importWords(pos, nWords, negative != 0);
+    pos += 8*static_cast<size_t>(nWords);
+
+    return true;
+}
+
+bool tsym::DagReader::readString(std::string& str)
+{
+    std::uint32_t length;
+
+    if (!readUint32(length))
+        return false;
+    else if (static_cast<size_t>(end - pos) < length)
+        return fail("String exceeds binary expression data");
+
+    str.assign(reinterpret_cast<const char*>(pos), length);
+    pos += length;
+
+    return true;
+}
+
+bool tsym::DagReader::readUint8(std::uint8_t& value)
+{
+    if (pos == end)
+        return fail("Unexpected end of binary expression data");
+
+    value = *pos++;
+
+    return true;
+}
+
+bool tsym::DagReader::readUint32(std::uint32_t& value)
+{
+    std::uint64_t wide = 0;
+
+    if (static_cast<size_t>(end - pos) < 4)
+        return fail("Unexpected end of binary expression data");
+
+    for (unsigned i = 0; i < 4; ++i)
+        wide |= static_cast<std::uint64_t>(*pos++) << 8*i;
+
+    value = static_cast<std::uint32_t>(wide);
+
+    return true;
+}
+
+bool tsym::DagReader::readUint64(std::uint64_t& value)
+{
+    if (static_cast<size_t>(end - pos) < 8)
+        return fail("Unexpected end of binary expression data");
+
+    value = 0;
+
+    for (unsigned i = 0; i < 8; ++i)
+        value |= static_cast<std::uint64_t>(*pos++) << 8*i;
+
+    return true;
+}
+
+bool tsym::DagReader::fail(const std::string& message)
+{
+    TSYM_ERROR(message);
+
+    return false;
+}
+
+bool tsym::DagReader::success() const
+{
+    return successful;
+}
+
+const tsym::BasePtrList& tsym::DagReader::getRoots() const
+{
+    return roots;
+}
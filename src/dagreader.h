@@ -0,0 +1,56 @@
+#ifndef TSYM_DAGREADER_H
+#define TSYM_DAGREADER_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "baseptr.h"
+#include "baseptrlist.h"
+#include "dagformat.h"
+
+namespace tsym { class Int; }
+
+namespace tsym {
+    class DagReader {
+        /* Restores expressions from the binary format described in dagformat.h. The given memory
+         * is read in place, e.g. from a memory-mapped file, and must outlive the reader object
+         * only during construction. Composite nodes are instantiated directly from their stored,
+         * already simplified operands, which is why this class is a friend of Sum, Product, Power
+         * and the functions. Each node is created once, such that shared subexpressions are shared
+         * in the result as well. Malformed input is detected (but not deliberately crafted
+         * expressions that aren't simplified), it results in an error log message and an empty
+         * list of roots. */
+        public:
+            DagReader(const char *data, size_t length);
+            DagReader(const DagReader& other) = delete;
+            const DagReader& operator = (const DagReader& rhs) = delete;
+
+            bool success() const;
+            const BasePtrList& getRoots() const;
+
+        private:
+            bool read();
+            bool readHeader();
+            bool readNode();
+            bool readNumber(dagFormat::Tag tag);
+            bool readSymbol(bool positive);
+            bool readComposite(dagFormat::Tag tag);
+            bool readFunction(dagFormat::Tag tag);
+            bool readRoots();
+            bool readIndex(BasePtr& operand);
+            bool readInt(Int& n);
+            bool readString(std::string& str);
+            bool readUint8(std::uint8_t& value);
+            bool readUint32(std::uint32_t& value);
+            bool readUint64(std::uint64_t& value);
+            bool fail(const std::string& message);
+
+            const unsigned char *pos;
+            const unsigned char *end;
+            std::vector<BasePtr> nodes;
+            BasePtrList roots;
+            bool successful;
+    };
+}
+
+#endif
@@ -0,0 +1,180 @@
+
+#include <cstring>
+#include <vector>
+#include "dagwriter.h"
+#include "base.h"
+#include "number.h"
+#include "logging.h"
+
+tsym::DagWriter::DagWriter(const BasePtrList& roots) :
+    nNodes(0)
+{
+    std::vector<std::uint32_t> rootIndices;
+
+    data.append(dagFormat::magic, sizeof(dagFormat::magic));
+    writeUint32(dagFormat::version);
+    writeUint32(0);
+
+    for (const auto& root : roots)
+        rootIndices.push_back(write(root));
+
+    patchUint32(sizeof(dagFormat::magic) + 4, nNodes);
+
+    writeUint32(static_cast<std::uint32_t>(rootIndices.size()));
+
+    for (const auto index : rootIndices)
+        writeUint32(index);
+}
+
+std::uint32_t tsym::DagWriter::write(const BasePtr& expr)
+    /* Operands are written first, such that any node refers to preceding ones only. */
+{
+    const auto lookup = indices.find(expr);
+    std::vector<std::uint32_t> operandIndices;
+
+    if (lookup != indices.end())
+        return lookup->second;
+
+    for (const auto& operand : expr->operands())
+        operandIndices.push_back(write(operand));
+
+    writeNode(expr, operandIndices);
+
+    return indices[expr] = nNodes++;
+}
+
+void tsym::DagWriter::writeNode(const BasePtr& expr, const std::vector<std::uint32_t>& operands)
+{
+    if (expr->isNumeric())
+        writeNumeric(expr);
+    else if (expr->isSymbol())
+        writeSymbol(expr);
+    else if (expr->isConstant())
+        writeTag(expr->name().getName() == "pi" ? dagFormat::PI : dagFormat::EULER);
+    else if (expr->isSum()) {
+        writeTag(dagFormat::SUM);
+        writeOperands(operands, true);
+    } else if (expr->isProduct()) {
+        writeTag(dagFormat::PRODUCT);
+        writeOperands(operands, true);
+    } else if (expr->isPower()) {
+        writeTag(dagFormat::POWER);
+        writeOperands(operands, false);
+    } else if (expr->isFunction())
+        writeFunction(expr, operands);
+    else
+        writeTag(dagFormat::UNDEFINED);
+}
+
+void tsym::DagWriter::writeNumeric(const BasePtr& numeric)
+{
+    const Number n(numeric->numericEval());
+
+    if (n.isInt()) {
+        writeTag(dagFormat::INTEGER);
+        writeInt(n.numerator());
+    } else if (n.isFrac()) {
+        writeTag(dagFormat::FRACTION);
+        writeInt(n.numerator());
+        writeInt(n.denominator());
+    } else {
+        std::uint64_t bits;
+        const double value = n.toDouble();
+
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        writeTag(dagFormat::DOUBLE);
+        writeUint64(bits);
+    }
+}
+
+void tsym::DagWriter::writeSymbol(const BasePtr& symbol)
+{
+    const Name& name(symbol->name());
+
+    if (name.isNumericId()) {
+        TSYM_ERROR("Temporary symbol ", symbol, " can't be serialized, write Undefined instead");
+        writeTag(dagFormat::UNDEFINED);
+        return;
+    }
+
+    writeTag(symbol->isPositive() ? dagFormat::POSITIVE_SYMBOL : dagFormat::SYMBOL);
+    writeString(name.getName());
+    writeString(name.getSubscript());
+    writeString(name.getSuperscript());
+}
+
+void tsym::DagWriter::writeFunction(const BasePtr& function,
+        const std::vector<std::uint32_t>& operands)
+{
+    static const std::unordered_map<std::string, dagFormat::Tag> tags { { "sin", dagFormat::SIN },
+        { "cos", dagFormat::COS }, { "tan", dagFormat::TAN }, { "asin", dagFormat::ASIN },
+        { "acos", dagFormat::ACOS }, { "atan", dagFormat::ATAN }, { "atan2", dagFormat::ATAN2 },
+        { "log", dagFormat::LOG } };
+    const auto lookup = tags.find(function->name().getName());
+
+    if (lookup == tags.end()) {
+        TSYM_ERROR("Unknown function ", function, " can't be serialized, write Undefined instead");
+        writeTag(dagFormat::UNDEFINED);
+    } else {
+        writeTag(lookup->second);
+        writeOperands(operands, false);
+    }
+}
+
+void tsym::DagWriter::writeOperands(const std::vector<std::uint32_t>& operands, bool withCount)
+{
+    if (withCount)
+        writeUint32(static_cast<std::uint32_t>(operands.size()));
+
+    for (const auto index : operands)
+        writeUint32(index);
+}
+
+void tsym::DagWriter::writeTag(dagFormat::Tag tag)
+{
+    data.push_back(static_cast<char>(tag));
+}
+
+void tsym::DagWriter::writeInt(const Int& n)
+{
+    const size_t nWords = n.nWords();
+    const size_t pos = data.size();
+
+    data.push_back(n < 0 ? 1 : 0);
+    writeUint32(static_cast<std::uint32_t>(nWords));
+
+    data.resize(data.size() + 8*nWords);
+
+    n.exportWords(reinterpret_cast<unsigned char*>(&data[pos + 5]));
+}
+
+void tsym::DagWriter::writeString(const std::string& str)
+{
+    writeUint32(static_cast<std::uint32_t>(str.size()));
+
+    data.append(str);
+}
+
+void tsym::DagWriter::writeUint32(std::uint32_t value)
+{
+    for (unsigned i = 0; i < 4; ++i)
+        data.push_back(static_cast<char>((value >> 8*i) & 0xff));
+}
+
+void tsym::DagWriter::writeUint64(std::uint64_t value)
+{
+    for (unsigned i = 0; i < 8; ++i)
+        data.push_back(static_cast<char>((value >> 8*i) & 0xff));
+}
+
+void tsym::DagWriter::patchUint32(size_t pos, std::uint32_t value)
+{
+    for (unsigned i = 0; i < 4; ++i)
+        data[pos + i] = static_cast<char>((value >> 8*i) & 0xff);
+}
+
+const std::string& tsym::DagWriter::get() const
+{
+    return data;
+}
@@ -0,0 +1,47 @@
+#ifndef TSYM_DAGWRITER_H
+#define TSYM_DAGWRITER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "baseptr.h"
+#include "baseptrlist.h"
+#include "dagformat.h"
+
+namespace tsym { class Int; }
+
+namespace tsym {
+    class DagWriter {
+        /* Writes expressions into the binary format described in dagformat.h. Identical
+         * subexpressions, also across different roots, are written only once. Temporary Symbols
+         * can't be serialized, they are written as Undefined. */
+        public:
+            explicit DagWriter(const BasePtrList& roots);
+            DagWriter(const DagWriter& other) = delete;
+            const DagWriter& operator = (const DagWriter& rhs) = delete;
+
+            const std::string& get() const;
+
+        private:
+            std::uint32_t write(const BasePtr& expr);
+            void writeNode(const BasePtr& expr, const std::vector<std::uint32_t>& operands);
+            void writeNumeric(const BasePtr& numeric);
+            void writeSymbol(const BasePtr& symbol);
+            void writeFunction(const BasePtr& function,
+                    const std::vector<std::uint32_t>& operands);
+            void writeOperands(const std::vector<std::uint32_t>& operands, bool withCount);
+            void writeTag(dagFormat::Tag tag);
+            void writeInt(const Int& n);
+            void writeString(const std::string& str);
+            void writeUint32(std::uint32_t value);
+            void writeUint64(std::uint64_t value);
+            void patchUint32(size_t pos, std::uint32_t value);
+
+            std::unordered_map<BasePtr, std::uint32_t> indices;
+            std::uint32_t nNodes;
+            std::string data;
+    };
+}
+
+#endif
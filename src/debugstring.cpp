@@ -0,0 +1,57 @@
+
+#include "debugstring.h"
+
+#ifdef TSYM_DEBUG_STRINGS
+
+#include <string>
+#include "bufferprinter.h"
+#include "baseptr.h"
+#include "base.h"
+#include "number.h"
+
+namespace tsym {
+    namespace {
+        std::string& debugString()
+        {
+            static std::string str;
+
+            str.clear();
+
+            return str;
+        }
+    }
+}
+
+const char *tsym_debugStringBase(const void *base)
+{
+    const tsym::Base *ptr = static_cast<const tsym::Base*>(base);
+    std::string& str(tsym::debugString());
+
+    if (base == nullptr)
+        return "nullptr";
+
+    /* The debugger is often stopped inside of a constructor, where the reference count is still
+     * zero. The temporary BasePtr would then delete the object, which is prevented by an
+     * additional reference: */
+    ++ptr->refCount;
+
+    tsym::BufferPrinter(str).print(tsym::BasePtr(ptr));
+
+    --ptr->refCount;
+
+    return str.c_str();
+}
+
+const char *tsym_debugStringNumber(const void *number)
+{
+    std::string& str(tsym::debugString());
+
+    if (number == nullptr)
+        return "nullptr";
+
+    tsym::BufferPrinter(str).print(*static_cast<const tsym::Number*>(number));
+
+    return str.c_str();
+}
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef TSYM_DEBUGSTRING_H
+#define TSYM_DEBUGSTRING_H
+
+#ifdef TSYM_DEBUG_STRINGS
+
+/* Functions for the gdb pretty printing plugin in misc/gdb/prettyprint.py. The text form of an
+ * expression is only computed when the debugger asks for it, i.e., no member of the Base or Number
+ * classes is filled during their construction. Arguments are the address of a Base or Number
+ * object, the returned string is valid until the next call to any of these functions. The address
+ * must point to a valid object, whose construction may still be in progress, as it can't be
+ * checked within the debugged process. C linkage keeps the names simple to call from gdb. */
+extern "C" {
+    const char *tsym_debugStringBase(const void *base);
+    const char *tsym_debugStringNumber(const void *number);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,351 @@
+
+#include <cassert>
+#include <algorithm>
+#include "densepoly.h"
+#include "sparsepoly.h"
+
+namespace tsym {
+    namespace {
+        /* Below this number of coefficients of the shorter factor, the quadratic number of
+         * multiplications is cheaper than the additional additions and allocations: */
+        const size_t karatsubaThreshold = 16;
+
+        void schoolbook(const Number *u, size_t nu, const Number *v, size_t nv, Number *result)
+            /* Adds the product to the nu + nv - 1 coefficients of the result. */
+        {
+            for (size_t i = 0; i < nu; ++i)
+                if (!u[i].isZero())
+                    for (size_t j = 0; j < nv; ++j)
+                        result[i + j] += u[i]*v[j];
+        }
+
+        void karatsuba(const Number *u, const Number *v, size_t n, Number *result)
+            /* Adds the product of two polynomials with n coefficients each to the result. With u =
+             * u0 + x^m*u1 and v likewise, the middle part u0*v1 + u1*v0 is computed by one
+             * multiplication as (u0 + u1)*(v0 + v1) - u0*v0 - u1*v1. */
+        {
+            if (n < karatsubaThreshold) {
+                schoolbook(u, n, v, n, result);
+                return;
+            }
+
+            const size_t m = n/2;
+            const size_t high = n - m;
+            std::vector<Number> low(2*m - 1);
+            std::vector<Number> top(2*high - 1);
+            std::vector<Number> middle(2*high - 1);
+            std::vector<Number> sumU(u + m, u + n);
+            std::vector<Number> sumV(v + m, v + n);
+
+            for (size_t i = 0; i < m; ++i) {
+                sumU[i] += u[i];
+                sumV[i] += v[i];
+            }
+
+            karatsuba(u, v, m, low.data());
+            karatsuba(u + m, v + m, high, top.data());
+            karatsuba(sumU.data(), sumV.data(), high, middle.data());
+
+            for (size_t i = 0; i < low.size(); ++i) {
+                result[i] += low[i];
+                middle[i] -= low[i];
+            }
+
+            for (size_t i = 0; i < top.size(); ++i) {
+                result[i + 2*m] += top[i];
+                middle[i] -= top[i];
+            }
+
+            for (size_t i = 0; i < middle.size(); ++i)
+                result[i + m] += middle[i];
+        }
+
+        void multiply(const Number *u, size_t nu, const Number *v, size_t nv, Number *result)
+            /* A longer factor is split into blocks of the length of the shorter one, such that
+             * Karatsuba's algorithm is applied to factors of equal length. */
+        {
+            size_t length;
+
+            if (nu < nv)
+                multiply(v, nv, u, nu, result);
+            else if (nv < karatsubaThreshold)
+                schoolbook(u, nu, v, nv, result);
+            else
+                for (size_t offset = 0; offset < nu; offset += nv) {
+                    length = std::min(nv, nu - offset);
+
+                    if (length == nv)
+                        karatsuba(u + offset, v, nv, result + offset);
+                    else
+                        multiply(v, nv, u + offset, length, result + offset);
+                }
+        }
+    }
+}
+
+tsym::DensePoly::DensePoly() {}
+
+tsym::DensePoly::DensePoly(std::vector<Number> coeffs) :
+    rep(std::move(coeffs))
+{
+    trim();
+}
+
+bool tsym::DensePoly::fromSparse(const SparsePoly& poly, DensePoly& result)
+{
+    std::vector<Number> coeffs(poly.isZero() ? 0 : static_cast<size_t>(poly.degree(0)) + 1);
+
+    for (const auto& term : poly.terms())
+        if (std::count(term.exp.begin() + 1, term.exp.end(), 0u) + 1 !=
+                static_cast<long>(term.exp.size()))
+            return false;
+        else
+            coeffs[term.exp.front()] = term.coeff;
+
+    result = DensePoly(std::move(coeffs));
+
+    return true;
+}
+
+tsym::SparsePoly tsym::DensePoly::toSparse(size_t nVariables) const
+{
+    std::vector<SparsePoly::Term> terms;
+
+    for (size_t i = rep.size(); i-- > 0; )
+        if (!rep[i].isZero()) {
+            terms.push_back({ SparsePoly::Exponents(nVariables, 0), rep[i] });
+            terms.back().exp.front() = static_cast<unsigned>(i);
+        }
+
+    return SparsePoly(nVariables, std::move(terms));
+}
+
+tsym::DensePoly& tsym::DensePoly::operator += (const DensePoly& rhs)
+{
+    addOrSubtract(rhs, false);
+
+    return *this;
+}
+
+tsym::DensePoly& tsym::DensePoly::operator -= (const DensePoly& rhs)
+{
+    addOrSubtract(rhs, true);
+
+    return *this;
+}
+
+void tsym::DensePoly::addOrSubtract(const DensePoly& rhs, bool subtract)
+{
+    if (rep.size() < rhs.rep.size())
+        rep.resize(rhs.rep.size());
+
+    for (size_t i = 0; i < rhs.rep.size(); ++i)
+        if (subtract)
+            rep[i] -= rhs.rep[i];
+        else
+            rep[i] += rhs.rep[i];
+
+    trim();
+}
+
+tsym::DensePoly& tsym::DensePoly::operator *= (const DensePoly& rhs)
+{
+    std::vector<Number> result;
+
+    if (isZero() || rhs.isZero()) {
+        rep.clear();
+        return *this;
+    }
+
+    result.resize(rep.size() + rhs.rep.size() - 1);
+
+    multiply(rep.data(), rep.size(), rhs.rep.data(), rhs.rep.size(), result.data());
+
+    rep.swap(result);
+    trim();
+
+    return *this;
+}
+
+tsym::DensePoly& tsym::DensePoly::operator *= (const Number& rhs)
+{
+    if (rhs.isZero())
+        rep.clear();
+
+    for (auto& coeff : rep)
+        coeff *= rhs;
+
+    return *this;
+}
+
+tsym::DensePoly tsym::DensePoly::operator - () const
+{
+    return *this*Number(-1);
+}
+
+void tsym::DensePoly::divide(const DensePoly& v, DensePoly& quotient, DensePoly& remainder) const
+{
+    const int n = v.degree();
+    const int m = degree();
+    Number factor;
+    Number inverse;
+
+    assert(!v.isZero());
+
+    quotient = DensePoly();
+    remainder = *this;
+
+    if (isZero() || m < n)
+        return;
+
+    inverse = Number(1)/v.leadingCoeff();
+    quotient.rep.resize(static_cast<size_t>(m - n + 1));
+
+    for (size_t k = quotient.rep.size(); k-- > 0; ) {
+        factor = remainder.rep[k + static_cast<size_t>(n)]*inverse;
+        quotient.rep[k] = factor;
+
+        if (!factor.isZero())
+            for (size_t j = 0; j <= static_cast<size_t>(n); ++j)
+                remainder.rep[j + k] -= factor*v.rep[j];
+    }
+
+    quotient.trim();
+    remainder.trim();
+}
+
+void tsym::DensePoly::pseudoDivide(const DensePoly& v, DensePoly& quotient,
+        DensePoly& remainder) const
+{
+    pseudoDivide(v, quotient, remainder, true);
+}
+
+tsym::DensePoly tsym::DensePoly::pseudoRemainder(const DensePoly& v) const
+{
+    DensePoly quotient;
+    DensePoly remainder;
+
+    pseudoDivide(v, quotient, remainder, false);
+
+    return remainder;
+}
+
+void tsym::DensePoly::pseudoDivide(const DensePoly& v, DensePoly& quotient,
+        DensePoly& remainder, bool computeQuotient) const
+    /* The steps are the same as in the sparse implementation, such that also the final factor
+     * applied to the results is identical. */
+{
+    const Number lCoeffV(v.leadingCoeff());
+    const int n = v.degree();
+    int m = degree();
+    size_t shift;
+    Number coeff;
+    int sigma = 0;
+
+    assert(!v.isZero());
+
+    quotient = DensePoly();
+    remainder = *this;
+
+    while (!remainder.isZero() && m >= n) {
+        shift = static_cast<size_t>(m - n);
+        coeff = remainder.rep[static_cast<size_t>(m)];
+
+        if (computeQuotient) {
+            quotient *= lCoeffV;
+            quotient.rep.resize(std::max(quotient.rep.size(), shift + 1));
+            quotient.rep[shift] += coeff;
+        }
+
+        remainder *= lCoeffV;
+
+        for (size_t j = 0; j < v.rep.size(); ++j)
+            remainder.rep[j + shift] -= coeff*v.rep[j];
+
+        remainder.trim();
+
+        if (remainder.isZero())
+            break;
+
+        ++sigma;
+        m = remainder.degree();
+    }
+
+    coeff = lCoeffV.toThe(std::max(degree() - n + 1, 0) - sigma);
+
+    remainder *= coeff;
+
+    if (computeQuotient) {
+        quotient.trim();
+        quotient *= coeff;
+    }
+}
+
+bool tsym::DensePoly::equal(const DensePoly& other) const
+{
+    return rep == other.rep;
+}
+
+bool tsym::DensePoly::isZero() const
+{
+    return rep.empty();
+}
+
+int tsym::DensePoly::degree() const
+{
+    return rep.empty() ? 0 : static_cast<int>(rep.size()) - 1;
+}
+
+tsym::Number tsym::DensePoly::leadingCoeff() const
+{
+    return rep.empty() ? Number(0) : rep.back();
+}
+
+const std::vector<tsym::Number>& tsym::DensePoly::coeffs() const
+{
+    return rep;
+}
+
+void tsym::DensePoly::trim()
+{
+    while (!rep.empty() && rep.back().isZero())
+        rep.pop_back();
+}
+
+bool tsym::operator == (const DensePoly& lhs, const DensePoly& rhs)
+{
+    return lhs.equal(rhs);
+}
+
+bool tsym::operator != (const DensePoly& lhs, const DensePoly& rhs)
+{
+    return !lhs.equal(rhs);
+}
+
+tsym::DensePoly tsym::operator + (DensePoly lhs, const DensePoly& rhs)
+{
+    lhs += rhs;
+
+    return lhs;
+}
+
+tsym::DensePoly tsym::operator - (DensePoly lhs, const DensePoly& rhs)
+{
+    lhs -= rhs;
+
+    return lhs;
+}
+
+tsym::DensePoly tsym::operator * (DensePoly lhs, const DensePoly& rhs)
+{
+    lhs *= rhs;
+
+    return lhs;
+}
+
+tsym::DensePoly tsym::operator * (DensePoly lhs, const Number& rhs)
+{
+    lhs *= rhs;
+
+    return lhs;
+}
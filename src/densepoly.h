@@ -0,0 +1,61 @@
+#ifndef TSYM_DENSEPOLY_H
+#define TSYM_DENSEPOLY_H
+
+#include <vector>
+#include "number.h"
+
+namespace tsym { class SparsePoly; }
+
+namespace tsym {
+    class DensePoly {
+        /* Univariate polynomial with rational coefficients in dense representation, i.e., an array
+         * of coefficients indexed by the exponent, without trailing zeros. This is used instead of
+         * SparsePoly when only one variable is involved, as no exponent vectors need to be compared
+         * or sorted, and large products can be computed by Karatsuba's algorithm. */
+        public:
+            DensePoly();
+            /* Coefficients of the exponents 0, 1, ..., which can have trailing zeros: */
+            explicit DensePoly(std::vector<Number> coeffs);
+
+            /* Returns false if the polynomial depends on another than the first variable: */
+            static bool fromSparse(const SparsePoly& poly, DensePoly& result);
+            SparsePoly toSparse(size_t nVariables) const;
+
+            DensePoly& operator += (const DensePoly& rhs);
+            DensePoly& operator -= (const DensePoly& rhs);
+            DensePoly& operator *= (const DensePoly& rhs);
+            DensePoly& operator *= (const Number& rhs);
+            DensePoly operator - () const;
+
+            /* Euclidean division over the rationals, the divisor must be non-zero: */
+            void divide(const DensePoly& v, DensePoly& quotient, DensePoly& remainder) const;
+            /* Same result as the pseudo-division of SparsePoly, see Cohen [2003], page 240: */
+            void pseudoDivide(const DensePoly& v, DensePoly& quotient, DensePoly& remainder) const;
+            DensePoly pseudoRemainder(const DensePoly& v) const;
+
+            bool equal(const DensePoly& other) const;
+            bool isZero() const;
+            /* Zero for a zero polynomial, as the degree method of the Base class does: */
+            int degree() const;
+            /* Zero for a zero polynomial: */
+            Number leadingCoeff() const;
+            const std::vector<Number>& coeffs() const;
+
+        private:
+            void addOrSubtract(const DensePoly& rhs, bool subtract);
+            void pseudoDivide(const DensePoly& v, DensePoly& quotient, DensePoly& remainder,
+                    bool computeQuotient) const;
+            void trim();
+
+            std::vector<Number> rep;
+    };
+
+    bool operator == (const DensePoly& lhs, const DensePoly& rhs);
+    bool operator != (const DensePoly& lhs, const DensePoly& rhs);
+    DensePoly operator + (DensePoly lhs, const DensePoly& rhs);
+    DensePoly operator - (DensePoly lhs, const DensePoly& rhs);
+    DensePoly operator * (DensePoly lhs, const DensePoly& rhs);
+    DensePoly operator * (DensePoly lhs, const Number& rhs);
+}
+
+#endif
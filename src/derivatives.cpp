@@ -0,0 +1,243 @@
+
+#include <unordered_map>
+#include "derivatives.h"
+#include "baseptr.h"
+#include "base.h"
+#include "symbol.h"
+#include "numeric.h"
+#include "sum.h"
+#include "product.h"
+#include "power.h"
+#include "logarithm.h"
+#include "undefined.h"
+#include "logging.h"
+
+namespace tsym {
+    namespace {
+        class ReverseAccumulation {
+            public:
+                std::vector<BasePtr> gradient(const BasePtr& expr,
+                        const std::vector<BasePtr>& symbols)
+                {
+                    std::vector<BasePtr> result;
+
+                    targets = &symbols;
+                    dependent.clear();
+                    order.clear();
+
+                    collect(expr);
+                    accumulate(expr);
+
+                    for (const auto& symbol : symbols)
+                        if (!symbol->isSymbol())
+                            result.push_back(Undefined::create());
+                        else if (adjoints.count(symbol) == 0)
+                            result.push_back(Numeric::zero());
+                        else
+                            result.push_back(adjoints[symbol]);
+
+                    adjoints.clear();
+
+                    return result;
+                }
+
+            private:
+                bool collect(const BasePtr& ptr)
+                    /* Post-order traversal of all subexpressions that depend on any of the target
+                     * symbols, without visiting shared subexpressions twice. */
+                {
+                    const auto lookup = dependent.find(ptr);
+                    bool result = false;
+
+                    if (lookup != dependent.end())
+                        return lookup->second;
+
+                    if (ptr->isSymbol())
+                        result = isTarget(ptr);
+                    else
+                        for (const auto& operand : ptr->operands())
+                            result = collect(operand) || result;
+
+                    if (result)
+                        order.push_back(ptr);
+
+                    return dependent[ptr] = result;
+                }
+
+                bool isTarget(const BasePtr& symbol) const
+                {
+                    for (const auto& target : *targets)
+                        if (target->isEqual(symbol))
+                            return true;
+
+                    return false;
+                }
+
+                void accumulate(const BasePtr& expr)
+                    /* The reversed post-order visits all parents of a node before the node itself,
+                     * such that its adjoint is complete when it's passed on to the operands. */
+                {
+                    std::unordered_map<BasePtr, BasePtrList> contributions;
+
+                    contributions[expr].push_back(Numeric::one());
+
+                    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+                        const BasePtr& node(*it);
+                        const BasePtr adjoint(Sum::create(contributions[node]));
+                        auto operand = node->operands().begin();
+
+                        adjoints[node] = adjoint;
+                        contributions.erase(node);
+
+                        if (node->isSymbol())
+                            continue;
+
+                        for (const auto& partial : localPartials(node)) {
+                            if (dependent[*operand])
+                                contributions[*operand].push_back(Product::create(adjoint,
+                                            partial));
+
+                            ++operand;
+                        }
+                    }
+                }
+
+                const std::vector<BasePtr>& localPartials(const BasePtr& node)
+                {
+                    const auto lookup = partials.find(node);
+                    std::vector<BasePtr> result;
+
+                    if (lookup != partials.end())
+                        return lookup->second;
+
+                    if (node->isSum())
+                        result.assign(node->operands().size(), Numeric::one());
+                    else if (node->isProduct())
+                        result = productPartials(node->operands());
+                    else if (node->isPower())
+                        result = powerPartials(node);
+                    else if (node->name().getName() == "atan2")
+                        result = atan2Partials(node->operands().front(), node->operands().back());
+                    else
+                        result.push_back(functionDerivative(node));
+
+                    return partials[node] = result;
+                }
+
+                std::vector<BasePtr> productPartials(const BasePtrList& factors) const
+                {
+                    std::vector<BasePtr> result;
+
+                    for (auto it = factors.begin(); it != factors.end(); ++it) {
+                        BasePtrList others;
+
+                        for (auto other = factors.begin(); other != factors.end(); ++other)
+                            if (other != it)
+                                others.push_back(*other);
+
+                        result.push_back(Product::create(others));
+                    }
+
+                    return result;
+                }
+
+                std::vector<BasePtr> powerPartials(const BasePtr& power) const
+                {
+                    const BasePtr base(power->base());
+                    const BasePtr exp(power->exp());
+                    const BasePtr wrtBase(Product::create(exp, Power::create(base,
+                                    Sum::create(exp, Numeric::mOne()))));
+
+                    return { wrtBase, Product::create(power, Logarithm::create(base)) };
+                }
+
+                std::vector<BasePtr> atan2Partials(const BasePtr& y, const BasePtr& x) const
+                {
+                    const BasePtr two(Numeric::create(2));
+                    const BasePtr denom(Power::oneOver(Sum::create(Power::create(x, two),
+                                    Power::create(y, two))));
+
+                    return { Product::create(x, denom), Product::minus(y, denom) };
+                }
+
+                BasePtr functionDerivative(const BasePtr& function) const
+                    /* The function is differentiated with respect to a temporary symbol in place of
+                     * its argument, which reuses the rules of the function classes. */
+                {
+                    const BasePtr& arg(function->operands().front());
+                    const BasePtr tmp(Symbol::createTmpSymbol());
+
+                    return function->subst(arg, tmp)->diff(tmp)->subst(tmp, arg);
+                }
+
+                const std::vector<BasePtr> *targets;
+                std::unordered_map<BasePtr, bool> dependent;
+                std::vector<BasePtr> order;
+                std::unordered_map<BasePtr, BasePtr> adjoints;
+                std::unordered_map<BasePtr, std::vector<BasePtr>> partials;
+        };
+
+        std::vector<BasePtr> toBasePtrs(const std::vector<Var>& symbols)
+        {
+            std::vector<BasePtr> result;
+
+            for (const auto& symbol : symbols) {
+                if (symbol.type() != Var::Type::SYMBOL)
+                    TSYM_ERROR("Differentiation w.r.t. ", symbol, "! Only Symbols work, ",
+                            "return Undefined.");
+
+                result.push_back(symbol.getBasePtr());
+            }
+
+            return result;
+        }
+    }
+}
+
+tsym::Vector tsym::gradient(const Var& expr, const std::vector<Var>& symbols)
+{
+    const std::vector<BasePtr> result(ReverseAccumulation().gradient(expr.getBasePtr(),
+                toBasePtrs(symbols)));
+    Vector grad(result.size());
+
+    for (size_t i = 0; i < result.size(); ++i)
+        grad(i) = Var(result[i]);
+
+    return grad;
+}
+
+tsym::Matrix tsym::jacobian(const Vector& functions, const std::vector<Var>& symbols)
+{
+    const std::vector<BasePtr> targets(toBasePtrs(symbols));
+    Matrix jac(functions.size(), symbols.size());
+    ReverseAccumulation accumulation;
+
+    for (size_t i = 0; i < functions.size(); ++i) {
+        const std::vector<BasePtr> row(accumulation.gradient(functions(i).getBasePtr(), targets));
+
+        for (size_t j = 0; j < row.size(); ++j)
+            jac(i, j) = Var(row[j]);
+    }
+
+    return jac;
+}
+
+tsym::Matrix tsym::hessian(const Var& expr, const std::vector<Var>& symbols)
+    /* For row i, only the symbols from i on are targets, such that subexpressions depending on
+     * preceding symbols only aren't traversed again. */
+{
+    const std::vector<BasePtr> targets(toBasePtrs(symbols));
+    ReverseAccumulation accumulation;
+    const std::vector<BasePtr> grad(accumulation.gradient(expr.getBasePtr(), targets));
+    Matrix hess(symbols.size(), symbols.size());
+
+    for (size_t i = 0; i < targets.size(); ++i) {
+        const std::vector<BasePtr> upper(targets.begin() + static_cast<long>(i), targets.end());
+        const std::vector<BasePtr> row(accumulation.gradient(grad[i], upper));
+
+        for (size_t j = i; j < targets.size(); ++j)
+            hess(i, j) = hess(j, i) = Var(row[j - i]);
+    }
+
+    return hess;
+}
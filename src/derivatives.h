@@ -0,0 +1,25 @@
+#ifndef TSYM_DERIVATIVES_H
+#define TSYM_DERIVATIVES_H
+
+#include <vector>
+#include "var.h"
+#include "vector.h"
+#include "matrix.h"
+
+namespace tsym {
+    /* Derivatives with respect to several symbols at once by reverse accumulation: the expression
+     * is traversed once from the root to the leafs, where every subexpression shared by
+     * different parents is treated only once, and the derivative with respect to every symbol is
+     * collected at the symbol itself. The local derivatives of a node with respect to its
+     * operands are computed once and reused for the rows of Jacobian and Hessian matrices. Hessians
+     * are computed as the upper triangle and mirrored.
+     *
+     * The results are equal to those of Var::diff, but not necessarily in the same form, i.e.,
+     * they can differ before normalization. Entries of the given symbols that aren't Symbols
+     * result in an error message and Undefined derivatives. */
+    Vector gradient(const Var& expr, const std::vector<Var>& symbols);
+    Matrix jacobian(const Vector& functions, const std::vector<Var>& symbols);
+    Matrix hessian(const Var& expr, const std::vector<Var>& symbols);
+}
+
+#endif
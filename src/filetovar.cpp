@@ -0,0 +1,247 @@
+
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+#include "filetovar.h"
+#include "mappedfile.h"
+#include "parseradapter.h"
+#include "context.h"
+#include "contextdata.h"
+#include "logging.h"
+
+namespace tsym {
+    namespace {
+        struct Line {
+            const char *begin;
+            size_t length;
+            unsigned number;
+        };
+
+        bool isBlank(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        template<class Fct> void forEachLine(const MappedFile& file, Fct fct)
+            /* Empty lines and comments are skipped, but they are counted for the line numbers. */
+        {
+            const char *end = file.begin() + file.length();
+            const char *pos = file.begin();
+            unsigned number = 0;
+
+            while (pos != nullptr && pos < end) {
+                const char *lineEnd = static_cast<const char*>(std::memchr(pos, '\n',
+                            static_cast<size_t>(end - pos)));
+                const char *next = lineEnd == nullptr ? nullptr : lineEnd + 1;
+                const char *firstChar = pos;
+
+                lineEnd = lineEnd == nullptr ? end : lineEnd;
+                ++number;
+
+                while (lineEnd > pos && *(lineEnd - 1) == '\r')
+                    --lineEnd;
+
+                while (firstChar < lineEnd && isBlank(*firstChar))
+                    ++firstChar;
+
+                if (firstChar < lineEnd && *firstChar != '#')
+                    fct(Line{ pos, static_cast<size_t>(lineEnd - pos), number });
+
+                pos = next;
+            }
+        }
+
+        std::vector<Line> splitIntoLines(const MappedFile& file)
+        {
+            std::vector<Line> lines;
+
+            forEachLine(file, [&lines](const Line& line) { lines.push_back(line); });
+
+            return lines;
+        }
+
+        std::string trim(const char *begin, const char *end)
+        {
+            while (begin < end && isBlank(*begin))
+                ++begin;
+
+            while (end > begin && isBlank(*(end - 1)))
+                --end;
+
+            return std::string(begin, end);
+        }
+
+        bool isNameChar(char c)
+        {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '{' || c == '}';
+        }
+
+        bool isValidName(const std::string& name)
+        {
+            if (name.empty() || !std::isalpha(static_cast<unsigned char>(name.front())))
+                return false;
+
+            return std::all_of(name.begin(), name.end(), isNameChar);
+        }
+
+        void registerError(FileToVar::Entry& entry, unsigned column, const std::string& message)
+        {
+            TSYM_ERROR("Line ", entry.line, ", column ", column, ": ", message);
+
+            if (entry.errors.empty())
+                entry.column = column;
+
+            entry.errors.push_back(message);
+        }
+
+        FileToVar::Entry parseLine(const Line& line, std::string& buffer)
+            /* The buffer is passed in to reuse its memory for the null-terminated copies of the
+             * expressions passed to the parser. */
+        {
+            const char *end = line.begin + line.length;
+            const char *assignment = static_cast<const char*>(std::memchr(line.begin, '=',
+                        line.length));
+            const char *exprBegin = assignment == nullptr ? line.begin : assignment + 1;
+            const unsigned exprOffset = static_cast<unsigned>(exprBegin - line.begin);
+            std::vector<std::string> errors;
+            unsigned errorIndex = 0;
+            FileToVar::Entry entry;
+
+            entry.line = line.number;
+            entry.column = 0;
+
+            if (assignment != nullptr) {
+                entry.name = trim(line.begin, assignment);
+
+                if (!isValidName(entry.name))
+                    registerError(entry, 1, "Invalid name of assignment: '" + entry.name + "'");
+            }
+
+            buffer.assign(exprBegin, end);
+
+            entry.expr = Var(parserAdapter::parse(buffer.c_str(), errors, errorIndex));
+
+            for (const auto& msg : errors)
+                registerError(entry, exprOffset + errorIndex + 1, msg);
+
+            return entry;
+        }
+
+        void parseChunk(std::vector<Line>::const_iterator first,
+                std::vector<Line>::const_iterator last,
+                std::vector<FileToVar::Entry>::iterator out)
+        {
+            std::string buffer;
+
+            for (auto line = first; line != last; ++line, ++out)
+                *out = parseLine(*line, buffer);
+        }
+
+        void parseChunkInOwnContext(const ContextData& settings,
+                std::vector<Line>::const_iterator first, std::vector<Line>::const_iterator last,
+                std::vector<FileToVar::Entry>::iterator out)
+        {
+            Context context;
+
+            context.data().adoptSettings(settings);
+
+            Context::install(&context);
+
+            parseChunk(first, last, out);
+
+            Context::install(nullptr);
+        }
+
+        void parseInParallel(const std::vector<Line>& lines,
+                std::vector<FileToVar::Entry>& entries, unsigned nThreads)
+        {
+            const ContextData& settings(Context::current().data());
+            const size_t chunkSize = (lines.size() + nThreads - 1)/nThreads;
+            std::vector<std::thread> threads;
+
+            for (size_t first = 0; first < lines.size(); first += chunkSize) {
+                const size_t last = std::min(first + chunkSize, lines.size());
+
+                threads.push_back(std::thread(parseChunkInOwnContext, std::cref(settings),
+                            lines.begin() + first, lines.begin() + last, entries.begin() + first));
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+        }
+    }
+}
+
+tsym::FileToVar::FileToVar(const std::string& filename, unsigned nThreads) :
+    readable(false),
+    errorFree(false)
+{
+    const MappedFile file(filename);
+
+    if (!file.isValid()) {
+        TSYM_ERROR("Can't read expressions from file '", filename, "'");
+        return;
+    }
+
+    const std::vector<Line> lines(splitIntoLines(file));
+
+    entries.resize(lines.size());
+
+    if (nThreads > 1 && lines.size() > 1)
+        parseInParallel(lines, entries, std::min<unsigned>(nThreads,
+                    static_cast<unsigned>(lines.size())));
+    else
+        parseChunk(lines.begin(), lines.end(), entries.begin());
+
+    readable = true;
+    errorFree = std::all_of(entries.begin(), entries.end(),
+            [](const Entry& entry) { return entry.errors.empty(); });
+}
+
+bool tsym::FileToVar::parse(const std::string& filename,
+        const std::function<void(const Entry& entry)>& callback)
+{
+    const MappedFile file(filename);
+    std::string buffer;
+
+    if (!file.isValid()) {
+        TSYM_ERROR("Can't read expressions from file '", filename, "'");
+        return false;
+    }
+
+    forEachLine(file, [&callback, &buffer](const Line& line) {
+            callback(parseLine(line, buffer)); });
+
+    return true;
+}
+
+bool tsym::FileToVar::success() const
+{
+    return readable && errorFree;
+}
+
+bool tsym::FileToVar::fileRead() const
+{
+    return readable;
+}
+
+size_t tsym::FileToVar::size() const
+{
+    return entries.size();
+}
+
+const tsym::FileToVar::Entry& tsym::FileToVar::operator [] (size_t i) const
+{
+    return entries[i];
+}
+
+tsym::FileToVar::const_iterator tsym::FileToVar::begin() const
+{
+    return entries.begin();
+}
+
+tsym::FileToVar::const_iterator tsym::FileToVar::end() const
+{
+    return entries.end();
+}
@@ -0,0 +1,57 @@
+#ifndef TSYM_FILETOVAR_H
+#define TSYM_FILETOVAR_H
+
+#include <vector>
+#include <string>
+#include <functional>
+#include "var.h"
+
+namespace tsym {
+    class FileToVar {
+        /* Parses all expressions of a text file in one pass. The file is memory-mapped, and every
+         * non-empty line is either a single expression (see StringToVar for the syntax) or an
+         * assignment of the form 'name = expression'. Lines starting with '#' are comments. Each
+         * line results in an Entry carrying the expression, the name of an assignment (empty
+         * otherwise) and, in case of errors, the messages together with line and column of the
+         * first erroneous character, both counting from one.
+         *
+         * With more than one thread, the lines are split into contiguous chunks that are parsed in
+         * parallel. Every worker thread uses its own Context with the settings of the calling
+         * thread, the resulting entries are in the order of the file nevertheless. */
+        public:
+            struct Entry {
+                std::string name;
+                Var expr;
+                unsigned line;
+                /* Zero for successfully parsed lines: */
+                unsigned column;
+                std::vector<std::string> errors;
+            };
+
+            typedef std::vector<Entry>::const_iterator const_iterator;
+
+            explicit FileToVar(const std::string& filename, unsigned nThreads = 1);
+            FileToVar(const FileToVar& other) = delete;
+            const FileToVar& operator = (const FileToVar& rhs) = delete;
+
+            /* Streams the entries of the given file to the callback in the order of the file,
+             * without storing them. Returns false if the file can't be read: */
+            static bool parse(const std::string& filename,
+                    const std::function<void(const Entry& entry)>& callback);
+
+            /* False if the file couldn't be read or any line contains errors: */
+            bool success() const;
+            bool fileRead() const;
+            size_t size() const;
+            const Entry& operator [] (size_t i) const;
+            const_iterator begin() const;
+            const_iterator end() const;
+
+        private:
+            std::vector<Entry> entries;
+            bool readable;
+            bool errorFree;
+    };
+}
+
+#endif
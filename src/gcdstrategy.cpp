@@ -61,19 +61,11 @@ tsym::BasePtr tsym::GcdStrategy::computeNumerics(const BasePtr& u, const BasePtr
     assert(numU.isRational() && numV.isRational());
 
     if (numU.isInt() && numV.isInt())
-        intGcd = integerGcd(numU.numerator(), numV.numerator());
+        intGcd = numU.numerator().gcd(numV.numerator());
 
     return Numeric::create(intGcd);
 }
 
-tsym::Int tsym::GcdStrategy::integerGcd(const Int& u, const Int& v) const
-{
-    if (v == 0)
-        return u;
-
-    return integerGcd(v, u % v);
-}
-
 bool tsym::GcdStrategy::haveCommonSymbol(const BasePtr& u, const BasePtr& v,
         const BasePtrList& L) const
 {
@@ -107,7 +99,7 @@ tsym::BasePtr tsym::GcdStrategy::integerContent(const BasePtr& u, const BasePtr&
     if (!uIntContent.isInt() || !vIntContent.isInt())
         return Numeric::one();
 
-    intGcd = integerGcd(uIntContent.numerator(), vIntContent.numerator());
+    intGcd = uIntContent.numerator().gcd(vIntContent.numerator());
 
     return Numeric::create(intGcd);
 }
@@ -134,20 +126,49 @@ tsym::Number tsym::GcdStrategy::integerContentOfSum(const BasePtrList& summands)
 
         assert(intContent.isInt());
 
-        result = integerGcd(result, intContent.numerator());
+        result = result.gcd(intContent.numerator());
     }
 
     return Number(result);
 }
 
 tsym::BasePtr tsym::GcdStrategy::normalize(const BasePtr& result, const BasePtrList& L) const
+    /* A gcd with non-integer coefficients is made a primitive polynomial with integer
+     * coefficients, as every strategy may return a different rational multiple of it. */
 {
+    const Number content(rationalContent(result->expand()));
     BasePtrList symbolListCopy(L);
+    BasePtr primitive(result);
     Number factor;
 
-    factor = normalizationFactor(result, symbolListCopy);
+    if (!content.isInt())
+        primitive = Product::create(Numeric::create(content.toThe(-1)), result)->expand();
+
+    factor = normalizationFactor(primitive, symbolListCopy);
+
+    return Product::create(Numeric::create(factor), primitive);
+}
+
+tsym::Number tsym::GcdStrategy::rationalContent(const BasePtr& poly) const
+    /* Returns the gcd of all numerators of the coefficients divided by the lcm of their
+     * denominators. */
+{
+    const BasePtrList summands(poly->isSum() ? poly->operands() : BasePtrList(poly));
+    Int numGcd(0);
+    Int denomLcm(1);
+    Number coeff;
+
+    for (const auto& summand : summands) {
+        coeff = summand->numericTerm()->numericEval();
+
+        if (!coeff.isRational())
+            return 1;
+
+        numGcd = numGcd.gcd(coeff.numerator());
+        denomLcm = denomLcm*coeff.denominator()/denomLcm.gcd(coeff.denominator());
+    }
 
-    return Product::create(Numeric::create(factor), result);
+    return Number(numGcd, denomLcm);
 }
 
 tsym::Number tsym::GcdStrategy::normalizationFactor(const BasePtr& arg, BasePtrList& L) const
@@ -33,13 +33,13 @@ namespace tsym {
 
         private:
             BasePtr computeNumerics(const BasePtr& u, const BasePtr& v) const;
-            Int integerGcd(const Int& a, const Int& b) const;
             bool haveCommonSymbol(const BasePtr& u, const BasePtr& v, const BasePtrList& L) const;
             BasePtr gcdViaAlgo(const BasePtr& u, const BasePtr& v, const BasePtrList& L) const;
             BasePtr integerContent(const BasePtr& u, const BasePtr& v) const;
             Number integerContent(const BasePtr& poly) const;
             Number integerContentOfSum(const BasePtrList& summands) const;
             BasePtr normalize(const BasePtr& result, const BasePtrList& L) const;
+            Number rationalContent(const BasePtr& poly) const;
             Number normalizationFactor(const BasePtr& arg, BasePtrList& L) const;
             virtual BasePtr gcdAlgo(const BasePtr& u, const BasePtr& v,
                     const BasePtrList& L) const = 0;
@@ -0,0 +1,170 @@
+
+
+#include <cmath>
+#include <algorithm>
+#include "heuristicgcd.h"
+#include "subresultantgcd.h"
+#include "sparsepoly.h"
+#include "numeric.h"
+#include "poly.h"
+#include "logging.h"
+
+namespace tsym {
+    namespace {
+        /* Geddes et al. [1992] give up when the integers of the innermost evaluation exceed
+         * about this number of bits: */
+        const double maxBits = 5000.0;
+        const unsigned maxTrials = 6;
+
+        bool heuristic(const SparsePoly& u, const SparsePoly& v, size_t nActive,
+                SparsePoly& result);
+
+        Int maxNorm(const SparsePoly& poly)
+        {
+            Int result(0);
+
+            for (const auto& term : poly.terms())
+                result = std::max(result, term.coeff.numerator().abs());
+
+            return result;
+        }
+
+        Int symmetricMod(const Int& n, const Int& modulus)
+        {
+            Int result(n % modulus);
+
+            if (result < 0)
+                result += modulus;
+
+            if (2*result > modulus)
+                result -= modulus;
+
+            return result;
+        }
+
+        SparsePoly interpolate(const SparsePoly& image, const Int& xi, size_t variable)
+            /* Expansion of the image coefficients in powers of xi with symmetric digits, which are
+             * the coefficients of the variable. */
+        {
+            std::vector<SparsePoly::Term> terms;
+            Int digit;
+            Int coeff;
+
+            for (const auto& term : image.terms()) {
+                coeff = term.coeff.numerator();
+
+                for (unsigned exp = 0; coeff != 0; ++exp) {
+                    digit = symmetricMod(coeff, xi);
+
+                    if (digit != 0) {
+                        terms.push_back({ term.exp, Number(digit) });
+                        terms.back().exp[variable] = exp;
+                    }
+
+                    coeff = (coeff - digit)/xi;
+                }
+            }
+
+            return SparsePoly(image.nVariables(), terms);
+        }
+
+        bool primitiveHeuristic(const SparsePoly& u, const SparsePoly& v, size_t nActive,
+                SparsePoly& result)
+            /* Both arguments have coprime integer coefficients, the variables 0, ..., nActive - 1
+             * may appear in them. */
+        {
+            const size_t variable = nActive - 1;
+            int maxDegree;
+            SparsePoly image;
+            SparsePoly candidate;
+            Int xi;
+
+            if (nActive == 0) {
+                result = SparsePoly(u.nVariables(), 1);
+                return true;
+            } else if ((maxDegree = std::max(u.degree(variable), v.degree(variable))) == 0)
+                return primitiveHeuristic(u, v, variable, result);
+
+            xi = 2*std::min(maxNorm(u), maxNorm(v)) + 2;
+
+            for (unsigned i = 0; i < maxTrials; ++i) {
+                if (std::log2(xi.toDouble())*maxDegree > maxBits)
+                    return false;
+                else if (heuristic(u.evaluate(variable, Number(xi)), v.evaluate(variable,
+                                Number(xi)), variable, image)) {
+                    candidate = interpolate(image, xi, variable).integerPrimitivePart();
+
+                    if (u.isDivisibleBy(candidate) && v.isDivisibleBy(candidate)) {
+                        result = candidate;
+                        return true;
+                    }
+                }
+
+                /* Pseudo-random increase, such that successive points don't share factors: */
+                xi = xi*73794/27011;
+            }
+
+            return false;
+        }
+
+        bool heuristic(const SparsePoly& u, const SparsePoly& v, size_t nActive,
+                SparsePoly& result)
+            /* Both arguments must have integer coefficients. The integer contents are divided out
+             * and their gcd is multiplied to the gcd of the primitive parts. */
+        {
+            SparsePoly primU;
+            SparsePoly primV;
+            Int content;
+
+            if (u.isZero() || v.isZero())
+                return false;
+
+            primU = u.integerPrimitivePart();
+            primV = v.integerPrimitivePart();
+            content = (u.terms().front().coeff.numerator()/
+                    primU.terms().front().coeff.numerator()).gcd(
+                    v.terms().front().coeff.numerator()/primV.terms().front().coeff.numerator());
+
+            if (!primitiveHeuristic(primU, primV, nActive, result))
+                return false;
+
+            result *= Number(content);
+
+            return true;
+        }
+
+        const GcdStrategy *subresultant()
+        {
+            static const SubresultantGcd algo;
+
+            return &algo;
+        }
+    }
+}
+
+tsym::HeuristicGcd::HeuristicGcd() :
+    fallback(subresultant())
+{}
+
+tsym::HeuristicGcd::HeuristicGcd(const GcdStrategy *fallback) :
+    fallback(fallback)
+{}
+
+tsym::BasePtr tsym::HeuristicGcd::gcdAlgo(const BasePtr& u, const BasePtr& v,
+        const BasePtrList& L) const
+{
+    const BasePtrList variables(SparsePoly::variables(L, u, v));
+    SparsePoly sparseU;
+    SparsePoly sparseV;
+    SparsePoly result;
+
+    if (!SparsePoly::fromBasePtr(u, variables, sparseU) ||
+            !SparsePoly::fromBasePtr(v, variables, sparseV)) {
+        TSYM_WARNING("Non-polynomial input for heuristic gcd computation, return 1.");
+        return Numeric::one();
+    } else if (heuristic(sparseU.integerPrimitivePart(), sparseV.integerPrimitivePart(),
+                variables.size(), result))
+        return result.toBasePtr(variables);
+
+    return poly::gcd(u, v, fallback);
+}
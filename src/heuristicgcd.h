@@ -0,0 +1,32 @@
+#ifndef TSYM_HEURISTICGCD_H
+#define TSYM_HEURISTICGCD_H
+
+#include "gcdstrategy.h"
+
+namespace tsym {
+    class HeuristicGcd : public GcdStrategy {
+        /* Heuristic gcd algorithm (GCDHEU) after Char, Geddes and Gonnet: the polynomials are
+         * evaluated at a large integer point, one variable after the other, and the gcd of the
+         * resulting integers is lifted back to a polynomial by its expansion in powers of the
+         * evaluation point. This is very fast for small degrees and coefficients, but limited by
+         * the size of the integers involved. A result is accepted only after trial division, and
+         * when all evaluation points fail, the given fallback algorithm (by default the
+         * subresultant one) is used.
+         *
+         * This strategy isn't the default, but available through poly::gcd(u, v, algo). It only
+         * beats the modular algorithm for dense polynomials in many variables, while it's about 20%
+         * to 35% slower for small uni- and trivariate gcds, which are much more frequent during
+         * normalization. */
+        public:
+            HeuristicGcd();
+            /* The fallback isn't owned and must outlive this instance: */
+            explicit HeuristicGcd(const GcdStrategy *fallback);
+
+        private:
+            BasePtr gcdAlgo(const BasePtr& u, const BasePtr& v, const BasePtrList& L) const;
+
+            const GcdStrategy *fallback;
+    };
+}
+
+#endif
@@ -188,6 +188,15 @@ tsym::Int tsym::Int::abs() const
     return result;
 }
 
+tsym::Int tsym::Int::gcd(const Int& other) const
+{
+    Int result;
+
+    mpz_gcd(result.handle, handle, other.handle);
+
+    return result;
+}
+
 bool tsym::Int::equal(const Int& rhs) const
 {
     return mpz_cmp(handle, rhs.handle) == 0;
@@ -246,6 +255,43 @@ double tsym::Int::toDouble() const
     return mpz_get_d(handle);
 }
 
+size_t tsym::Int::bitLength() const
+{
+    if (mpz_sgn(handle) == 0)
+        return 0;
+
+    return mpz_sizeinbase(handle, 2);
+}
+
+size_t tsym::Int::nWords() const
+{
+    return (bitLength() + 63)/64;
+}
+
+void tsym::Int::exportWords(unsigned char *dest) const
+{
+    size_t count;
+
+    mpz_export(dest, &count, -1, 8, -1, 0, handle);
+
+    assert(count == nWords());
+
+    /* To avoid an unused variable warning for release builds: */
+    (void)count;
+}
+
+tsym::Int tsym::Int::importWords(const unsigned char *src, size_t nWords, bool negative)
+{
+    Int result;
+
+    mpz_import(result.handle, nWords, -1, 8, -1, 0, src);
+
+    if (negative)
+        mpz_neg(result.handle, result.handle);
+
+    return result;
+}
+
 void tsym::Int::print(std::ostream& stream) const
 {
     char *buffer = nullptr;
@@ -270,6 +316,18 @@ void tsym::Int::print(std::ostream& stream) const
     delete[] buffer;
 }
 
+void tsym::Int::appendTo(std::string& str) const
+{
+    const size_t oldLength = str.length();
+
+    /* The size in base 10 may exceed the actual number of digits by one, plus sign and null: */
+    str.resize(oldLength + mpz_sizeinbase(handle, 10) + 2);
+
+    mpz_get_str(&str[oldLength], 10, handle);
+
+    str.resize(oldLength + std::strlen(&str[oldLength]));
+}
+
 bool tsym::operator == (const Int& lhs, const Int& rhs)
 {
     return lhs.equal(rhs);
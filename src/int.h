@@ -2,6 +2,7 @@
 #define TSYM_INT_H
 
 #include <iostream>
+#include <string>
 #include <cstddef>
 #include <functional>
 #include "gmp.h"
@@ -44,6 +45,8 @@ namespace tsym {
             /* Returns 0 if the exponent < 0: */
             Int toThe(const Int& exp) const;
             Int abs() const;
+            /* Returns the non-negative greatest common divisor: */
+            Int gcd(const Int& other) const;
 
             bool equal(const Int& rhs) const;
             bool lessThan(const Int& rhs) const;
@@ -53,8 +56,18 @@ namespace tsym {
             int toInt() const;
             long toLong() const;
             double toDouble() const;
+            /* Number of bits of the absolute value, zero for zero: */
+            size_t bitLength() const;
+            /* Conversion of the absolute value to and from a sequence of little-endian 64 bit
+             * words (i.e., the gmp limbs on common platforms), e.g. for binary serialization. The
+             * byte buffers don't need to be aligned, and the sign is treated separately: */
+            size_t nWords() const;
+            void exportWords(unsigned char *dest) const;
+            static Int importWords(const unsigned char *src, size_t nWords, bool negative);
 
             void print(std::ostream& stream) const;
+            /* Appends the decimal representation without iostream overhead: */
+            void appendTo(std::string& str) const;
 
         private:
             Int nonTrivialPower(const Int& exp) const;
@@ -0,0 +1,146 @@
+
+#include <algorithm>
+#include "kronecker.h"
+
+namespace tsym {
+    namespace {
+        typedef SparsePoly::Exponents Exponents;
+
+        const size_t wordSize = 8;
+        /* Multivariate polynomials of some total degree fill only a fraction of the slots: */
+        const size_t maxSlotsPerProduct = 4;
+
+        bool maxBitLength(const SparsePoly& poly, size_t& result)
+        {
+            result = 0;
+
+            for (const auto& term : poly.terms())
+                if (!term.coeff.isInt())
+                    return false;
+                else
+                    result = std::max(result, term.coeff.numerator().bitLength());
+
+            return true;
+        }
+
+        bool strides(const SparsePoly& u, const SparsePoly& v, size_t maxSlots,
+                std::vector<size_t>& result)
+            /* Every variable gets a range of exponents that is larger than its degree in the
+             * product. Returns false if the total number of slots exceeds the given maximum. */
+        {
+            const size_t nVars = u.nVariables();
+            size_t stride = 1;
+            size_t range;
+
+            result.resize(nVars + 1);
+
+            for (size_t i = nVars; i-- > 0; ) {
+                result[i + 1] = stride;
+                range = static_cast<size_t>(u.degree(i) + v.degree(i)) + 1;
+
+                if (stride > maxSlots/range)
+                    return false;
+
+                stride *= range;
+            }
+
+            result.front() = stride;
+
+            return true;
+        }
+
+        Int pack(const SparsePoly& poly, const std::vector<size_t>& strides, size_t slotWords)
+            /* Positive and negative coefficients are packed separately and subtracted, such that
+             * only absolute values are written into the slots. */
+        {
+            const size_t nSlots = strides.front();
+            std::vector<unsigned char> positive(nSlots*slotWords*wordSize, 0);
+            std::vector<unsigned char> negative(positive.size(), 0);
+            size_t index;
+
+            for (const auto& term : poly.terms()) {
+                const Int& coeff(term.coeff.numerator());
+
+                index = 0;
+
+                for (size_t i = 0; i < term.exp.size(); ++i)
+                    index += term.exp[i]*strides[i + 1];
+
+                coeff.exportWords((coeff < 0 ? negative : positive).data() +
+                        index*slotWords*wordSize);
+            }
+
+            return Int::importWords(positive.data(), nSlots*slotWords, false) -
+                Int::importWords(negative.data(), nSlots*slotWords, false);
+        }
+
+        void unpack(const Int& product, const std::vector<size_t>& strides, size_t slotWords,
+                std::vector<SparsePoly::Term>& terms)
+            /* Slots are read from the least significant one, a slot above half of its range
+             * represents a negative coefficient and borrows one from the next slot. */
+        {
+            const size_t nSlots = strides.front();
+            const size_t nVars = strides.size() - 1;
+            const Int base(Int(2).toThe(Int(static_cast<long>(64*slotWords))));
+            const Int half(base/2);
+            const bool negate = product < 0;
+            std::vector<unsigned char> buffer(std::max(product.nWords(), nSlots*slotWords)*
+                    wordSize, 0);
+            Exponents exp(nVars);
+            Int carry(0);
+            Int digit;
+
+            product.exportWords(buffer.data());
+
+            for (size_t index = 0; index < nSlots; ++index) {
+                digit = Int::importWords(buffer.data() + index*slotWords*wordSize, slotWords,
+                        false) + carry;
+
+                if (digit >= half) {
+                    digit -= base;
+                    carry = 1;
+                } else
+                    carry = 0;
+
+                if (digit == 0)
+                    continue;
+
+                for (size_t i = 0; i < nVars; ++i)
+                    exp[i] = static_cast<unsigned>(index/strides[i + 1] %
+                            (strides[i]/strides[i + 1]));
+
+                terms.push_back({ exp, Number(negate ? -digit : digit) });
+            }
+        }
+    }
+}
+
+bool tsym::kroneckerMultiply(const SparsePoly& u, const SparsePoly& v, SparsePoly& result)
+    /* The substitution is dense in all variables, it is only used if the number of slots doesn't
+     * exceed a small multiple of the number of pairwise products of the schoolbook
+     * multiplication. The slot size bounds the product coefficients by the number of terms times
+     * the maximal factors, plus a sign bit. */
+{
+    const size_t nVars = u.nVariables();
+    const size_t minTerms = std::min(u.terms().size(), v.terms().size());
+    std::vector<SparsePoly::Term> terms;
+    std::vector<size_t> slots;
+    size_t bitsU;
+    size_t bitsV;
+    size_t slotWords;
+
+    if (u.isZero() || v.isZero() || nVars != v.nVariables())
+        return false;
+    else if (!maxBitLength(u, bitsU) || !maxBitLength(v, bitsV))
+        return false;
+    else if (!strides(u, v, maxSlotsPerProduct*u.terms().size()*v.terms().size(), slots))
+        return false;
+
+    slotWords = (bitsU + bitsV + Int(static_cast<long>(minTerms)).bitLength() + 1 + 63)/64;
+
+    unpack(pack(u, slots, slotWords)*pack(v, slots, slotWords), slots, slotWords, terms);
+
+    result = SparsePoly(nVars, std::move(terms));
+
+    return true;
+}
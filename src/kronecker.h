@@ -0,0 +1,17 @@
+#ifndef TSYM_KRONECKER_H
+#define TSYM_KRONECKER_H
+
+#include "sparsepoly.h"
+
+namespace tsym {
+    /* Multiplication of polynomials with integer coefficients by Kronecker substitution: the
+     * variables are replaced by powers of one variable, chosen such that no exponents of the
+     * product overlap, and this variable is evaluated at a power of two large enough to hold
+     * every coefficient of the product. The result of one big integer multiplication, for which
+     * gmp switches to FFT-based algorithms at large sizes, is then split back into coefficients.
+     * Returns false and leaves the result unchanged if a coefficient isn't an integer or if the
+     * polynomials are too sparse for the substitution to pay off. */
+    bool kroneckerMultiply(const SparsePoly& u, const SparsePoly& v, SparsePoly& result);
+}
+
+#endif
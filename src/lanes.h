@@ -0,0 +1,94 @@
+#ifndef TSYM_LANES_H
+#define TSYM_LANES_H
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__GNUC__) && !defined(TSYM_WITHOUT_SIMD) && (defined(__SSE2__) || defined(__AVX__))
+#include <immintrin.h>
+#endif
+
+namespace tsym {
+    /* Number of doubles that batch evaluation of compiled expressions processes together. This is
+     * the width of one vector register of the target, as passing wider vectors by value would
+     * depend on the instruction set the library is compiled for (gcc warns with -Wpsabi). */
+#ifdef __AVX__
+    const size_t nLanes = 4;
+#else
+    const size_t nLanes = 2;
+#endif
+
+#if defined(__GNUC__) && !defined(TSYM_WITHOUT_SIMD)
+    /* Vector extension of gcc and clang, such that arithmetic operations are translated into SSE or
+     * AVX instructions, depending on the target. The alignment is reduced to allow for storing the
+     * lanes in plain arrays of doubles. */
+    typedef double Lanes __attribute__((vector_size(nLanes*sizeof(double)), aligned(sizeof(double)),
+                may_alias));
+
+    inline Lanes sqrt(const Lanes& x)
+    {
+#if defined(__AVX__)
+        return (Lanes) _mm256_sqrt_pd((__m256d) x);
+#elif defined(__SSE2__)
+        return (Lanes) _mm_sqrt_pd((__m128d) x);
+#else
+        Lanes result;
+
+        for (size_t i = 0; i < nLanes; ++i)
+            result[i] = std::sqrt(x[i]);
+
+        return result;
+#endif
+    }
+#else
+    /* Scalar fallback with the same interface, i.e., elementwise arithmetic and subscripting: */
+    struct Lanes {
+        double& operator [] (size_t i) { return value[i]; }
+        const double& operator [] (size_t i) const { return value[i]; }
+
+        double value[nLanes];
+    };
+
+    template<class Fct> inline Lanes elementwise(const Lanes& lhs, const Lanes& rhs, Fct fct)
+    {
+        Lanes result;
+
+        for (size_t i = 0; i < nLanes; ++i)
+            result[i] = fct(lhs[i], rhs[i]);
+
+        return result;
+    }
+
+    inline Lanes operator + (const Lanes& lhs, const Lanes& rhs)
+    {
+        return elementwise(lhs, rhs, [](double x, double y) { return x + y; });
+    }
+
+    inline Lanes operator - (const Lanes& lhs, const Lanes& rhs)
+    {
+        return elementwise(lhs, rhs, [](double x, double y) { return x - y; });
+    }
+
+    inline Lanes operator * (const Lanes& lhs, const Lanes& rhs)
+    {
+        return elementwise(lhs, rhs, [](double x, double y) { return x*y; });
+    }
+
+    inline Lanes operator / (const Lanes& lhs, const Lanes& rhs)
+    {
+        return elementwise(lhs, rhs, [](double x, double y) { return x/y; });
+    }
+
+    inline Lanes operator - (const Lanes& operand)
+    {
+        return elementwise(operand, operand, [](double x, double) { return -x; });
+    }
+
+    inline Lanes sqrt(const Lanes& x)
+    {
+        return elementwise(x, x, [](double y, double) { return std::sqrt(y); });
+    }
+#endif
+}
+
+#endif
@@ -24,9 +24,7 @@ namespace tsym {
 tsym::Logarithm::Logarithm(const BasePtr& arg) :
     Function(BasePtrList(arg), "log"),
     arg(ops.front())
-{
-    setDebugString();
-}
+{}
 
 tsym::Logarithm::~Logarithm() {}
 
@@ -119,7 +117,7 @@ tsym::Fraction tsym::Logarithm::normal(SymbolMap& map) const
 
 tsym::BasePtr tsym::Logarithm::diffWrtSymbol(const BasePtr& symbol) const
 {
-    return Product::create(Power::oneOver(arg), arg->diffWrtSymbol(symbol));
+    return Product::create(Power::oneOver(arg), arg->diff(symbol));
 }
 
 tsym::BasePtr tsym::Logarithm::subst(const BasePtr& from, const BasePtr& to) const
@@ -7,6 +7,8 @@ namespace tsym {
     class Logarithm : public Function {
         /* Natural Logarithm with respect to basis e. */
         public:
+            friend class DagReader;
+
             static BasePtr create(const BasePtr& arg);
 
             /* Implentations of pure virtual methods of Base. */
@@ -2,19 +2,39 @@
 #define TSYM_LOGGING_H
 
 #include <cstring>
+#include <mutex>
 #include "plic/plic.h"
+#include "loglevel.h"
+
+#ifndef TSYM_MIN_LOG_LEVEL
+#define TSYM_MIN_LOG_LEVEL 0
+#endif
+
+#define TSYM_LOG_LEVEL_DEBUG 0
+#define TSYM_LOG_LEVEL_INFO 1
+#define TSYM_LOG_LEVEL_WARNING 2
+#define TSYM_LOG_LEVEL_ERROR 3
+#define TSYM_LOG_LEVEL_CRITICAL 4
 
 #define TSYM_FILE (std::strrchr(__FILE__, '/') ? std::strrchr(__FILE__, '/') + 1 : __FILE__)
 
-#define TSYM_DEBUG(...) plic::debug("tsym", plic::FILENAME, TSYM_FILE, plic::LINE, __LINE__, \
-        __VA_ARGS__)
-#define TSYM_INFO(...) plic::info("tsym", plic::FILENAME, TSYM_FILE, plic::LINE, __LINE__, \
-        __VA_ARGS__)
-#define TSYM_WARNING(...) plic::warning("tsym", plic::FILENAME, TSYM_FILE, plic::LINE, __LINE__, \
-        __VA_ARGS__)
-#define TSYM_ERROR(...) plic::error("tsym", plic::FILENAME, TSYM_FILE, plic::LINE, __LINE__, \
-        __VA_ARGS__)
-#define TSYM_CRITICAL(...) plic::critical("tsym", plic::FILENAME, TSYM_FILE, plic::LINE, __LINE__, \
-        __VA_ARGS__)
+/* True if messages of the given level, e.g. TSYM_LOG_LEVEL_DEBUG, are compiled in and pass the
+ * runtime threshold. To be used for skipping work that is only done for logging, e.g. measuring
+ * time. The compile-time part is a constant, such that disabled branches are removed entirely. */
+#define TSYM_LOG_ENABLED(level) ((level) >= TSYM_MIN_LOG_LEVEL && \
+        tsym::isLogEnabled(static_cast<tsym::LogLevel>(level)))
+
+/* Messages are passed to the backend one at a time, as it isn't necessarily thread-safe, while
+ * messages can be issued by the worker threads of parallel parsing, expansion or normalization. */
+#define TSYM_LOG(level, fct, ...) do { if (TSYM_LOG_ENABLED(level)) { \
+    std::lock_guard<std::recursive_mutex> tsymLogLock(tsym::logMutex()); \
+    plic::fct("tsym", plic::FILENAME, TSYM_FILE, plic::LINE, __LINE__, __VA_ARGS__); } } \
+    while (false)
+
+#define TSYM_DEBUG(...) TSYM_LOG(TSYM_LOG_LEVEL_DEBUG, debug, __VA_ARGS__)
+#define TSYM_INFO(...) TSYM_LOG(TSYM_LOG_LEVEL_INFO, info, __VA_ARGS__)
+#define TSYM_WARNING(...) TSYM_LOG(TSYM_LOG_LEVEL_WARNING, warning, __VA_ARGS__)
+#define TSYM_ERROR(...) TSYM_LOG(TSYM_LOG_LEVEL_ERROR, error, __VA_ARGS__)
+#define TSYM_CRITICAL(...) TSYM_LOG(TSYM_LOG_LEVEL_CRITICAL, critical, __VA_ARGS__)
 
 #endif
@@ -0,0 +1,32 @@
+
+#include <atomic>
+#include <mutex>
+#include "loglevel.h"
+
+namespace tsym {
+    namespace {
+        std::atomic<int> threshold(static_cast<int>(LogLevel::DEBUG));
+    }
+}
+
+void tsym::setLogLevel(LogLevel level)
+{
+    threshold.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+tsym::LogLevel tsym::getLogLevel()
+{
+    return static_cast<LogLevel>(threshold.load(std::memory_order_relaxed));
+}
+
+bool tsym::isLogEnabled(LogLevel level)
+{
+    return static_cast<int>(level) >= threshold.load(std::memory_order_relaxed);
+}
+
+std::recursive_mutex& tsym::logMutex()
+{
+    static std::recursive_mutex mutex;
+
+    return mutex;
+}
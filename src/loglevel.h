@@ -0,0 +1,23 @@
+#ifndef TSYM_LOGLEVEL_H
+#define TSYM_LOGLEVEL_H
+
+#include <mutex>
+
+namespace tsym {
+    /* Runtime threshold for the log messages of this library. Messages below the given level are
+     * discarded before any of their arguments are formatted or passed to the logging backend,
+     * which is cheaper than filtering them by the backend configuration. The default lets all
+     * messages pass. Independent of this setting, messages below the compile-time level given by
+     * the TSYM_MIN_LOG_LEVEL macro (0 for DEBUG up to 4 for CRITICAL) are removed from the library
+     * entirely, which is done for DEBUG and INFO in release builds. */
+    enum class LogLevel { DEBUG, INFO, WARNING, ERROR, CRITICAL, NONE };
+
+    void setLogLevel(LogLevel level);
+    LogLevel getLogLevel();
+    bool isLogEnabled(LogLevel level);
+    /* To be used only internally, serializes the calls to the logging backend. It's recursive,
+     * because the formatting of a message might issue another one: */
+    std::recursive_mutex& logMutex();
+}
+
+#endif
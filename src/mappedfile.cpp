@@ -0,0 +1,56 @@
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "mappedfile.h"
+
+tsym::MappedFile::MappedFile(const std::string& filename) :
+    data(nullptr),
+    size(0),
+    valid(false)
+{
+    struct stat info;
+    const int fd = open(filename.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        return;
+    else if (fstat(fd, &info) == 0)
+        map(fd, static_cast<size_t>(info.st_size));
+
+    close(fd);
+}
+
+void tsym::MappedFile::map(int fd, size_t fileSize)
+{
+    void *mapped = fileSize == 0 ? nullptr : mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd,
+            0);
+
+    if (mapped == MAP_FAILED)
+        return;
+
+    data = static_cast<const char*>(mapped);
+    size = fileSize;
+    valid = true;
+}
+
+tsym::MappedFile::~MappedFile()
+{
+    if (data != nullptr)
+        munmap(const_cast<char*>(data), size);
+}
+
+bool tsym::MappedFile::isValid() const
+{
+    return valid;
+}
+
+const char *tsym::MappedFile::begin() const
+{
+    return data;
+}
+
+size_t tsym::MappedFile::length() const
+{
+    return size;
+}
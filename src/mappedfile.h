@@ -0,0 +1,30 @@
+#ifndef TSYM_MAPPEDFILE_H
+#define TSYM_MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+namespace tsym {
+    class MappedFile {
+        /* Read-only memory mapping of a whole file, unmapped on destruction. Empty files can't be
+         * mapped, but they are valid nonetheless, with a null pointer as beginning. */
+        public:
+            explicit MappedFile(const std::string& filename);
+            MappedFile(const MappedFile& other) = delete;
+            const MappedFile& operator = (const MappedFile& rhs) = delete;
+            ~MappedFile();
+
+            bool isValid() const;
+            const char *begin() const;
+            size_t length() const;
+
+        private:
+            void map(int fd, size_t fileSize);
+
+            const char *data;
+            size_t size;
+            bool valid;
+    };
+}
+
+#endif
@@ -5,6 +5,9 @@
 #include "numeric.h"
 #include "logging.h"
 #include "printer.h"
+#include "context.h"
+#include "contextdata.h"
+#include "parallel.h"
 
 namespace tsym {
     namespace {
@@ -305,14 +308,17 @@ tsym::Vector tsym::Matrix::solve(const Vector& rhs) const
 
 tsym::Vector tsym::Matrix::solveChecked(const Vector& rhs) const
 {
-    auto ts = std::chrono::high_resolution_clock::now();
+    const bool logTiming = TSYM_LOG_ENABLED(TSYM_LOG_LEVEL_INFO);
+    std::chrono::high_resolution_clock::time_point ts;
     std::chrono::microseconds ms;
     unsigned nPivotSwaps;
-    decltype(ts) te;
     Matrix PLU(*this);
     Vector b(rhs);
     Vector x(nRow);
 
+    if (logTiming)
+        ts = std::chrono::high_resolution_clock::now();
+
     nPivotSwaps = PLU.compPartialPivots(&b);
     PLU.factorizeLU();
 
@@ -322,11 +328,12 @@ tsym::Vector tsym::Matrix::solveChecked(const Vector& rhs) const
     } else {
         PLU.compXFromLU(x, b);
 
-        te = std::chrono::high_resolution_clock::now();
-        ms = std::chrono::duration_cast<std::chrono::microseconds>(te - ts);
-
-        TSYM_INFO("Solved %zu-dim. system of equations in %.2f ms.", nRow,
-                static_cast<float>(ms.count())/1000.0);
+        if (logTiming) {
+            ms = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::high_resolution_clock::now() - ts);
+            TSYM_INFO("Solved %zu-dim. system of equations in %.2f ms.", nRow,
+                    static_cast<float>(ms.count())/1000.0);
+        }
     }
 
     return x;
@@ -406,19 +413,36 @@ tsym::Matrix tsym::Matrix::inverse() const
 }
 
 tsym::Matrix tsym::Matrix::checkedInverse() const
+    /* The matrix is factorized once, the columns of the inverse are then solved independently of
+     * each other by forward and back substitution, in parallel if configured so (see Context).
+     * The row swaps of the pivoting are recorded by applying them to the row indices. */
 {
+    const ContextData& settings(Context::current().data());
+    const unsigned nThreads = nRow >= settings.parallelInverseThreshold ?
+        settings.normalizationThreads : 1;
     Matrix inverse(nRow, nRow);
-    Vector inverseCol;
-    Vector b(nRow);
+    Vector rowIndices(nRow);
+    Matrix PLU(*this);
 
-    for (size_t i = 0; i < nRow; ++i, b.data[i - 1] = 0) {
-        b.data[i] = 1;
+    for (size_t i = 0; i < nRow; ++i)
+        rowIndices.data[i] = Var(static_cast<int>(i));
 
-        inverseCol = solve(b);
+    PLU.compPartialPivots(&rowIndices);
+    PLU.factorizeLU();
 
-        for (size_t j = 0; j < nRow; ++j)
-            inverse.data[j][i] = inverseCol.data[j];
-    }
+    runInParallel(nRow, nThreads, [&](size_t i, unsigned) {
+            Vector inverseCol(nRow);
+            Vector b(nRow);
+
+            for (size_t j = 0; j < nRow; ++j)
+                if (rowIndices.data[j].toInt() == static_cast<int>(i))
+                    b.data[j] = 1;
+
+            PLU.compXFromLU(inverseCol, b);
+
+            for (size_t j = 0; j < nRow; ++j)
+                inverse.data[j][i] = inverseCol.data[j];
+            });
 
     return inverse;
 }
@@ -0,0 +1,96 @@
+
+#include "modular.h"
+
+namespace tsym {
+    namespace modular {
+        namespace {
+            std::vector<Residue> largePrimes(size_t n)
+            {
+                std::vector<Residue> result;
+                bool isPrime;
+
+                for (Residue candidate = 2147483647; result.size() < n; candidate -= 2) {
+                    isPrime = true;
+
+                    for (Residue divisor = 3; divisor*divisor <= candidate && isPrime; divisor += 2)
+                        isPrime = candidate % divisor != 0;
+
+                    if (isPrime)
+                        result.push_back(candidate);
+                }
+
+                return result;
+            }
+        }
+    }
+}
+
+tsym::modular::Residue tsym::modular::power(Residue base, Residue exp, Residue p)
+{
+    Residue result = 1;
+
+    base %= p;
+
+    while (exp != 0) {
+        if (exp & 1u)
+            result = result*base % p;
+
+        base = base*base % p;
+        exp >>= 1;
+    }
+
+    return result;
+}
+
+tsym::modular::Residue tsym::modular::inverse(Residue n, Residue p)
+    /* Fermat's little theorem, as p is prime. */
+{
+    return power(n, p - 2, p);
+}
+
+tsym::modular::Residue tsym::modular::reduce(const Int& n, Residue p)
+{
+    const long rem = (n % Int(static_cast<long>(p))).toLong();
+
+    return static_cast<Residue>(rem < 0 ? rem + static_cast<long>(p) : rem);
+}
+
+bool tsym::modular::isPrime(Residue n)
+    /* The bases 2, 7 and 61 are sufficient for all n < 4759123141. */
+{
+    Residue d = n - 1;
+    unsigned s = 0;
+    Residue x;
+
+    if (n < 2)
+        return false;
+    else if (n == 2 || n == 7 || n == 61)
+        return true;
+    else if (n % 2 == 0)
+        return false;
+
+    for (; d % 2 == 0; ++s)
+        d /= 2;
+
+    for (const Residue a : { 2, 7, 61 }) {
+        x = power(a, d, n);
+
+        if (x == 1 || x == n - 1)
+            continue;
+
+        for (unsigned i = 1; i < s && x != n - 1; ++i)
+            x = x*x % n;
+
+        if (x != n - 1)
+            return false;
+    }
+
+    return true;
+}
+
+const std::vector<tsym::modular::Residue>& tsym::modular::primes()
+{
+    static const std::vector<Residue> list(largePrimes(64));
+
+    return list;
+}
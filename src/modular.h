@@ -0,0 +1,26 @@
+#ifndef TSYM_MODULAR_H
+#define TSYM_MODULAR_H
+
+#include <cstdint>
+#include <vector>
+#include "int.h"
+
+namespace tsym {
+    /* Arithmetic modulo primes below 2^31, such that the product of two residues fits into 64
+     * bit. */
+    namespace modular {
+        typedef std::uint64_t Residue;
+
+        Residue power(Residue base, Residue exp, Residue p);
+        /* The argument must not be a multiple of p: */
+        Residue inverse(Residue n, Residue p);
+        /* Returns the non-negative remainder of n/p: */
+        Residue reduce(const Int& n, Residue p);
+        /* Deterministic Miller-Rabin test for arguments below 2^31: */
+        bool isPrime(Residue n);
+        /* The 64 largest primes below 2^31 in descending order: */
+        const std::vector<Residue>& primes();
+    }
+}
+
+#endif
@@ -0,0 +1,528 @@
+
+#include <map>
+#include <cstdint>
+#include <algorithm>
+#include "modulargcd.h"
+#include "modular.h"
+#include "subresultantgcd.h"
+#include "sparsepoly.h"
+#include "numeric.h"
+#include "poly.h"
+#include "logging.h"
+
+namespace tsym {
+    namespace {
+        typedef modular::Residue Residue;
+        typedef SparsePoly::Exponents Exponents;
+
+        struct ModTerm {
+            Exponents exp;
+            Residue coeff;
+        };
+
+        class ModPoly {
+            /* Polynomial with coefficients modulo a prime below 2^31, such that the product of two
+             * coefficients fits into 64 bit. Terms are ordered like those of SparsePoly. */
+            public:
+                ModPoly(Residue p = 2, size_t nVars = 0) :
+                    p(p),
+                    nVars(nVars)
+                {}
+
+                ModPoly(Residue p, size_t nVars, std::vector<ModTerm> unsorted) :
+                    p(p),
+                    nVars(nVars)
+                {
+                    collect(unsorted);
+                }
+
+                ModPoly(const SparsePoly& poly, Residue p) :
+                    p(p),
+                    nVars(poly.nVariables())
+                    /* The coefficients of the given polynomial must be integers. */
+                {
+                    for (const auto& term : poly.terms()) {
+                        const Residue coeff = modular::reduce(term.coeff.numerator(), p);
+
+                        if (coeff != 0)
+                            terms.push_back({ term.exp, coeff });
+                    }
+                }
+
+                static ModPoly constant(Residue p, size_t nVars, Residue c)
+                {
+                    return ModPoly(p, nVars, { { Exponents(nVars, 0), c } });
+                }
+
+                static ModPoly linear(Residue p, size_t nVars, size_t variable, Residue alpha)
+                    /* Returns variable - alpha. */
+                {
+                    Exponents exp(nVars, 0);
+
+                    exp[variable] = 1;
+
+                    return ModPoly(p, nVars, { { exp, 1 }, { Exponents(nVars, 0), p - alpha } });
+                }
+
+                bool isZero() const
+                {
+                    return terms.empty();
+                }
+
+                bool isConstant() const
+                {
+                    return terms.empty() || (terms.size() == 1 &&
+                            terms.front().exp == Exponents(nVars, 0));
+                }
+
+                const Exponents& leadingMonomial() const
+                {
+                    return terms.front().exp;
+                }
+
+                unsigned degree(size_t variable) const
+                {
+                    unsigned result = 0;
+
+                    for (const auto& term : terms)
+                        result = std::max(result, term.exp[variable]);
+
+                    return result;
+                }
+
+                Residue prime() const
+                {
+                    return p;
+                }
+
+                const std::vector<ModTerm>& getTerms() const
+                {
+                    return terms;
+                }
+
+                Residue evaluateUnivariate(size_t variable, Residue alpha) const
+                {
+                    Residue result = 0;
+
+                    for (const auto& term : terms)
+                        result = (result + term.coeff*modular::power(alpha, term.exp[variable],
+                                    p)) % p;
+
+                    return result;
+                }
+
+                ModPoly evaluate(size_t variable, Residue alpha) const
+                {
+                    std::vector<ModTerm> result(terms);
+
+                    for (auto& term : result) {
+                        term.coeff = term.coeff*modular::power(alpha, term.exp[variable], p) % p;
+                        term.exp[variable] = 0;
+                    }
+
+                    return ModPoly(p, nVars, result);
+                }
+
+                ModPoly addScaled(const ModPoly& other, Residue factor) const
+                    /* Returns this + factor*other by merging the sorted terms. */
+                {
+                    auto lhs = terms.cbegin();
+                    auto rhs = other.terms.cbegin();
+                    ModPoly result(p, nVars);
+                    Residue coeff;
+
+                    while (lhs != terms.cend() || rhs != other.terms.cend())
+                        if (rhs == other.terms.cend() ||
+                                (lhs != terms.cend() && lhs->exp > rhs->exp))
+                            result.terms.push_back(*lhs++);
+                        else if (lhs == terms.cend() || rhs->exp > lhs->exp) {
+                            coeff = rhs->coeff*factor % p;
+
+                            if (coeff != 0)
+                                result.terms.push_back({ rhs->exp, coeff });
+
+                            ++rhs;
+                        } else {
+                            coeff = (lhs->coeff + rhs->coeff*factor) % p;
+
+                            if (coeff != 0)
+                                result.terms.push_back({ lhs->exp, coeff });
+
+                            ++lhs;
+                            ++rhs;
+                        }
+
+                    return result;
+                }
+
+                ModPoly operator * (const ModPoly& other) const
+                {
+                    std::vector<ModTerm> products;
+
+                    products.reserve(terms.size()*other.terms.size());
+
+                    for (const auto& lhs : terms)
+                        for (const auto& rhs : other.terms) {
+                            products.push_back({ lhs.exp, lhs.coeff*rhs.coeff % p });
+
+                            for (size_t i = 0; i < nVars; ++i)
+                                products.back().exp[i] += rhs.exp[i];
+                        }
+
+                    return ModPoly(p, nVars, products);
+                }
+
+                ModPoly shifted(const Exponents& exp, Residue factor) const
+                    /* Multiplication by a monomial doesn't change the order of terms. */
+                {
+                    ModPoly result(*this);
+
+                    for (auto& term : result.terms) {
+                        term.coeff = term.coeff*factor % p;
+
+                        for (size_t i = 0; i < nVars; ++i)
+                            term.exp[i] += exp[i];
+                    }
+
+                    return result;
+                }
+
+                ModPoly monic() const
+                {
+                    return shifted(Exponents(nVars, 0), modular::inverse(terms.front().coeff, p));
+                }
+
+                bool divideExact(const ModPoly& divisor, ModPoly& quotient) const
+                    /* Multivariate division by leading terms, which succeeds for every term of the
+                     * remainder exactly if the divisor is a factor. */
+                {
+                    const Exponents& divisorLm(divisor.leadingMonomial());
+                    const Residue inverse = modular::inverse(divisor.terms.front().coeff, p);
+                    ModPoly remainder(*this);
+                    Exponents exp(nVars);
+                    Residue coeff;
+
+                    quotient = ModPoly(p, nVars);
+
+                    while (!remainder.isZero()) {
+                        for (size_t i = 0; i < nVars; ++i)
+                            if (remainder.leadingMonomial()[i] < divisorLm[i])
+                                return false;
+                            else
+                                exp[i] = remainder.leadingMonomial()[i] - divisorLm[i];
+
+                        coeff = remainder.terms.front().coeff*inverse % p;
+
+                        quotient.terms.push_back({ exp, coeff });
+                        remainder = remainder.addScaled(divisor.shifted(exp, 1), p - coeff);
+                    }
+
+                    return true;
+                }
+
+                ModPoly remainder(const ModPoly& divisor, size_t variable) const
+                    /* Both polynomials must be univariate in the given variable. */
+                {
+                    const unsigned n = divisor.degree(variable);
+                    const Residue inverse = modular::inverse(divisor.terms.front().coeff, p);
+                    ModPoly result(*this);
+                    Exponents exp(nVars, 0);
+                    Residue coeff;
+
+                    while (!result.isZero() && result.degree(variable) >= n) {
+                        exp[variable] = result.degree(variable) - n;
+                        coeff = result.terms.front().coeff*inverse % p;
+                        result = result.addScaled(divisor.shifted(exp, 1), p - coeff);
+                    }
+
+                    return result;
+                }
+
+                ModPoly contentInLast(size_t last) const;
+                ModPoly leadingCoeffInLast(size_t last) const;
+
+            private:
+                void collect(std::vector<ModTerm>& unsorted)
+                {
+                    std::sort(unsorted.begin(), unsorted.end(),
+                            [](const ModTerm& lhs, const ModTerm& rhs) {
+                                return lhs.exp > rhs.exp;
+                            });
+
+                    for (const auto& term : unsorted)
+                        if (!terms.empty() && terms.back().exp == term.exp)
+                            terms.back().coeff = (terms.back().coeff + term.coeff) % p;
+                        else if (!terms.empty() && terms.back().coeff == 0)
+                            terms.back() = term;
+                        else
+                            terms.push_back(term);
+
+                    if (!terms.empty() && terms.back().coeff == 0)
+                        terms.pop_back();
+                }
+
+                std::vector<ModPoly> coeffsInLast(size_t last) const;
+
+                Residue p;
+                size_t nVars;
+                std::vector<ModTerm> terms;
+        };
+
+        ModPoly univariateGcd(ModPoly u, ModPoly v, size_t variable)
+        {
+            ModPoly remainder;
+
+            while (!v.isZero()) {
+                remainder = u.remainder(v, variable);
+                u = v;
+                v = remainder;
+            }
+
+            return u.isZero() ? u : u.monic();
+        }
+
+        std::vector<ModPoly> ModPoly::coeffsInLast(size_t last) const
+            /* The last variable is the least significant one with non-zero exponents, terms that
+             * only differ in its exponent are thus adjacent. */
+        {
+            std::vector<ModPoly> result;
+            auto sameExceptLast = [last](const Exponents& lhs, const Exponents& rhs) {
+                return std::equal(lhs.begin(), lhs.begin() + static_cast<long>(last), rhs.begin());
+            };
+            Exponents exp(nVars, 0);
+
+            for (auto it = terms.cbegin(); it != terms.cend(); ++it) {
+                if (it == terms.cbegin() || !sameExceptLast(it->exp, (it - 1)->exp))
+                    result.push_back(ModPoly(p, nVars));
+
+                exp[last] = it->exp[last];
+                result.back().terms.push_back({ exp, it->coeff });
+            }
+
+            return result;
+        }
+
+        ModPoly ModPoly::contentInLast(size_t last) const
+        {
+            ModPoly result(p, nVars);
+
+            for (const auto& coeff : coeffsInLast(last)) {
+                result = univariateGcd(result, coeff, last);
+
+                if (result.isConstant())
+                    break;
+            }
+
+            return result;
+        }
+
+        ModPoly ModPoly::leadingCoeffInLast(size_t last) const
+        {
+            return coeffsInLast(last).front();
+        }
+
+        bool denseGcd(const ModPoly& u, const ModPoly& v, size_t nActive, ModPoly& result)
+            /* Brown's algorithm for the variables 0, ..., nActive - 1: the last of them is
+             * eliminated by evaluation and recovered by Newton interpolation of the gcd images,
+             * which are scaled by the gcd of the leading coefficients to make them agree. The
+             * result is monic. */
+        {
+            const Residue p = u.prime();
+            const size_t nVars = u.leadingMonomial().size();
+            const size_t last = nActive - 1;
+            ModPoly content;
+            ModPoly primU;
+            ModPoly primV;
+            ModPoly lcU;
+            ModPoly lcV;
+            ModPoly lcGcd;
+            ModPoly interpolant;
+            ModPoly newton;
+            ModPoly image;
+            ModPoly primitive;
+            ModPoly unused;
+            Exponents leading;
+            unsigned nPoints = 0;
+            unsigned bound;
+
+            if (nActive == 1) {
+                result = univariateGcd(u, v, 0);
+                return true;
+            }
+
+            content = univariateGcd(u.contentInLast(last), v.contentInLast(last), last);
+            u.divideExact(u.contentInLast(last), primU);
+            v.divideExact(v.contentInLast(last), primV);
+            lcU = primU.leadingCoeffInLast(last);
+            lcV = primV.leadingCoeffInLast(last);
+            lcGcd = univariateGcd(lcU, lcV, last);
+            bound = lcGcd.degree(last) + std::min(primU.degree(last), primV.degree(last));
+
+            for (Residue alpha = 0; alpha < p; ++alpha) {
+                if (lcU.evaluateUnivariate(last, alpha) == 0 ||
+                        lcV.evaluateUnivariate(last, alpha) == 0)
+                    continue;
+                else if (!denseGcd(primU.evaluate(last, alpha), primV.evaluate(last, alpha), last,
+                            image))
+                    return false;
+
+                image = image.shifted(Exponents(nVars, 0), lcGcd.evaluateUnivariate(last, alpha));
+
+                if (nPoints > 0 && leading < image.leadingMonomial())
+                    /* Unlucky evaluation point with a gcd of higher degree. */
+                    continue;
+                else if (nPoints == 0 || image.leadingMonomial() < leading) {
+                    interpolant = image;
+                    newton = ModPoly::linear(p, nVars, last, alpha);
+                    leading = image.leadingMonomial();
+                    nPoints = 1;
+                } else {
+                    image = image.addScaled(interpolant.evaluate(last, alpha), p - 1);
+                    interpolant = interpolant.addScaled(image*newton,
+                            modular::inverse(newton.evaluateUnivariate(last, alpha), p));
+                    newton = newton*ModPoly::linear(p, nVars, last, alpha);
+                    ++nPoints;
+                }
+
+                if (nPoints <= bound)
+                    continue;
+
+                interpolant.divideExact(interpolant.contentInLast(last), primitive);
+
+                if (primU.divideExact(primitive, unused) && primV.divideExact(primitive, unused)) {
+                    result = (content*primitive).monic();
+                    return true;
+                }
+
+                nPoints = 0;
+            }
+
+            return false;
+        }
+
+        void combine(std::map<Exponents, Int>& images, const Int& modulus, const ModPoly& image)
+            /* Chinese remaindering of the accumulated coefficients with the new image. */
+        {
+            const Residue p = image.prime();
+            const Residue inverse = modular::inverse(modular::reduce(modulus, p), p);
+            std::map<Exponents, Residue> residues;
+            Residue diff;
+
+            for (const auto& term : image.getTerms()) {
+                residues[term.exp] = term.coeff;
+                images.insert({ term.exp, Int(0) });
+            }
+
+            for (auto& entry : images) {
+                const auto lookup = residues.find(entry.first);
+                const Residue target = lookup == residues.end() ? 0 : lookup->second;
+
+                diff = (target + p - modular::reduce(entry.second, p)) % p*inverse % p;
+                entry.second += modulus*Int(static_cast<long>(diff));
+            }
+        }
+
+        bool rationalReconstruction(const Int& n, const Int& modulus, Number& result)
+            /* Wang's algorithm, numerator and denominator are bound by sqrt(modulus/2). */
+        {
+            Int r0(modulus);
+            Int r1(n);
+            Int s0(0);
+            Int s1(1);
+            Int quotient;
+            Int tmp;
+
+            while (2*r1*r1 >= modulus) {
+                quotient = r0/r1;
+                tmp = r0 - quotient*r1;
+                r0 = r1;
+                r1 = tmp;
+                tmp = s0 - quotient*s1;
+                s0 = s1;
+                s1 = tmp;
+            }
+
+            if (s1 == 0 || 2*s1*s1 >= modulus)
+                return false;
+
+            result = Number(r1, s1);
+
+            return true;
+        }
+
+        bool reconstruct(const std::map<Exponents, Int>& images, const Int& modulus, size_t nVars,
+                SparsePoly& result)
+        {
+            std::vector<SparsePoly::Term> terms;
+            Number coeff;
+
+            for (const auto& entry : images)
+                if (!rationalReconstruction(entry.second, modulus, coeff))
+                    return false;
+                else
+                    terms.push_back({ entry.first, coeff });
+
+            result = SparsePoly(nVars, terms).integerPrimitivePart();
+
+            return true;
+        }
+
+        const GcdStrategy *fallback()
+        {
+            static const SubresultantGcd algo;
+
+            return &algo;
+        }
+    }
+}
+
+tsym::BasePtr tsym::ModularGcd::gcdAlgo(const BasePtr& u, const BasePtr& v,
+        const BasePtrList& L) const
+{
+    const BasePtrList variables(SparsePoly::variables(L, u, v));
+    std::map<Exponents, Int> images;
+    SparsePoly sparseU;
+    SparsePoly sparseV;
+    SparsePoly candidate;
+    Exponents leading;
+    Int modulus(1);
+    ModPoly image;
+
+    if (!SparsePoly::fromBasePtr(u, variables, sparseU) ||
+            !SparsePoly::fromBasePtr(v, variables, sparseV)) {
+        TSYM_WARNING("Non-polynomial input for modular gcd computation, return 1.");
+        return Numeric::one();
+    }
+
+    sparseU = sparseU.integerPrimitivePart();
+    sparseV = sparseV.integerPrimitivePart();
+
+    for (const Residue p : modular::primes()) {
+        if (modular::reduce(sparseU.terms().front().coeff.numerator(), p) == 0 ||
+                modular::reduce(sparseV.terms().front().coeff.numerator(), p) == 0)
+            continue;
+        else if (!denseGcd(ModPoly(sparseU, p), ModPoly(sparseV, p), variables.size(), image))
+            continue;
+        else if (image.isConstant())
+            return Numeric::one();
+
+        if (images.empty() || image.leadingMonomial() < leading) {
+            images.clear();
+            modulus = 1;
+            leading = image.leadingMonomial();
+        } else if (leading < image.leadingMonomial())
+            /* Unlucky prime. */
+            continue;
+
+        combine(images, modulus, image);
+        modulus *= Int(static_cast<long>(p));
+
+        if (reconstruct(images, modulus, variables.size(), candidate) &&
+                sparseU.isDivisibleBy(candidate) && sparseV.isDivisibleBy(candidate))
+            return candidate.toBasePtr(variables);
+    }
+
+    TSYM_WARNING("Modular gcd of ", u, " and ", v, " failed, use subresultant algorithm.");
+
+    return poly::gcd(u, v, fallback());
+}
@@ -0,0 +1,20 @@
+#ifndef TSYM_MODULARGCD_H
+#define TSYM_MODULARGCD_H
+
+#include "gcdstrategy.h"
+
+namespace tsym {
+    class ModularGcd : public GcdStrategy {
+        /* Modular gcd algorithm after Brown: the polynomials are reduced modulo word-sized primes,
+         * where their gcd is computed by evaluation and interpolation of one variable after the
+         * other. The monic images are combined by chinese remaindering and rational
+         * reconstruction, and the result is accepted only after trial division of both arguments.
+         * Coefficients don't grow during the computation, which pays off for dense polynomials in
+         * several variables. If no result is found with the internal list of primes, the
+         * subresultant algorithm is used instead. */
+        private:
+            BasePtr gcdAlgo(const BasePtr& u, const BasePtr& v, const BasePtrList& L) const;
+    };
+}
+
+#endif
@@ -4,7 +4,7 @@
 #include <iostream>
 #include <limits>
 #include "number.h"
-#include "printer.h"
+#include "bufferprinter.h"
 #include "logging.h"
 
 const double tsym::Number::ZERO_TOL = std::numeric_limits<double>::epsilon();
@@ -97,10 +97,6 @@ void tsym::Number::simplify()
 
     if (isFrac())
         cancel();
-
-#ifdef TSYM_DEBUG_STRINGS
-    prettyStr = Printer(*this).getStr();
-#endif
 }
 
 void tsym::Number::tryDoubleToFraction()
@@ -579,11 +575,13 @@ tsym::Number tsym::operator / (Number lhs, const Number& rhs)
 
 std::ostream& tsym::operator << (std::ostream& stream, const Number& rhs)
 {
-    Printer printer(rhs);
+    std::string str;
+    BufferPrinter printer(str);
 
-    printer.print(stream);
+    printer.print(rhs);
 
-    return stream;
+    /* Inserted as a whole, such that the width and fill settings of the stream apply: */
+    return stream << str;
 }
 
 size_t std::hash<tsym::Number>::operator () (const tsym::Number& n) const
@@ -86,11 +86,6 @@ namespace tsym {
             bool undefined;
             static const double TOL;
             static const double ZERO_TOL;
-
-#ifdef TSYM_DEBUG_STRINGS
-            /* A member to be accessed by a gdb pretty printing plugin. */
-            std::string prettyStr;
-#endif
     };
 
     bool operator == (const Number& lhs, const Number& rhs);
@@ -4,9 +4,7 @@
 
 tsym::Numeric::Numeric(const Number& number) :
     number(number)
-{
-    setDebugString();
-}
+{}
 
 tsym::Numeric::~Numeric() {}
 
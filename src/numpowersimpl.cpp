@@ -2,15 +2,15 @@
 #include <cassert>
 #include <cmath>
 #include "numpowersimpl.h"
+#include "context.h"
+#include "contextdata.h"
 #include "logging.h"
 
 namespace tsym {
     namespace {
-        Int& primeFacLimit()
+        const Int& primeFacLimit()
         {
-            static Int limit(1000);
-
-            return limit;
+            return Context::current().data().maxPrimeResolution;
         }
     }
 }
@@ -38,7 +38,8 @@ void tsym::NumPowerSimpl::setPreFac(const Number& fac)
 
 void tsym::NumPowerSimpl::setMaxPrimeResolution(const Int& max)
 {
-    primeFacLimit() = max;
+    ContextData::setDefaultMaxPrimeResolution(max);
+    Context::current().data().setMaxPrimeResolution(max);
 }
 
 const tsym::Number& tsym::NumPowerSimpl::getNewBase()
@@ -9,8 +9,9 @@ namespace tsym {
         /* Class for the simplification of a numeric power or a product of a numeric power and a
          * numeric. Purpose is the definition of the simplest possible representation (mainly done
          * by minimizing the number of primes in the power expression) up to a certain upper bound
-         * (that can be set for all instances of this class via a method, the default value is 1000)
-         * of numbers due to high computational costs of prime factorization. Examples are:
+         * (that is stored in the current Context and can be set via a static method for the current
+         * and all Contexts created afterwards, the default value is 1000) of numbers due to high
+         * computational costs of prime factorization. Examples are:
          *
          * - simple resolvable power, sqrt(4) = 2
          * - extraction of base sign, 2*(-5)^(1/3) = (-2)*5^(1/3)
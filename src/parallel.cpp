@@ -0,0 +1,54 @@
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "parallel.h"
+#include "context.h"
+#include "contextdata.h"
+
+namespace tsym {
+    namespace {
+        void runTasks(size_t nTasks, unsigned thread, std::atomic<size_t>& next,
+                const std::function<void(size_t task, unsigned thread)>& task)
+        {
+            size_t i;
+
+            while ((i = next.fetch_add(1)) < nTasks)
+                task(i, thread);
+        }
+
+        void runTasksInOwnContext(const ContextData& settings, size_t nTasks, unsigned thread,
+                std::atomic<size_t>& next,
+                const std::function<void(size_t task, unsigned thread)>& task)
+        {
+            Context context;
+
+            context.data().adoptSettings(settings);
+
+            Context::install(&context);
+
+            runTasks(nTasks, thread, next, task);
+
+            Context::install(nullptr);
+        }
+    }
+}
+
+void tsym::runInParallel(size_t nTasks, unsigned nThreads,
+        const std::function<void(size_t task, unsigned thread)>& task)
+{
+    const ContextData& settings(Context::current().data());
+    const unsigned nUsed = static_cast<unsigned>(std::min<size_t>(nThreads, nTasks));
+    std::vector<std::thread> threads;
+    std::atomic<size_t> next(0);
+
+    for (unsigned thread = 1; thread < nUsed; ++thread)
+        threads.push_back(std::thread(runTasksInOwnContext, std::cref(settings), nTasks, thread,
+                    std::ref(next), std::cref(task)));
+
+    runTasks(nTasks, 0, next, task);
+
+    for (auto& thread : threads)
+        thread.join();
+}
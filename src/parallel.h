@@ -0,0 +1,20 @@
+#ifndef TSYM_PARALLEL_H
+#define TSYM_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace tsym {
+    /* Calls the given task for every index in [0, nTasks) on the calling thread and up to nThreads
+     * - 1 additional ones. Whenever a thread is done with a task, it takes the next index from a
+     * shared counter, such that threads finishing early go on with the remaining work of the
+     * others. The additional threads use their own Context with the simplification settings of
+     * the calling one, which is hence not accessed concurrently. Expressions can be shared between
+     * the tasks, as their reference counts are atomic. The second argument of the task identifies
+     * the thread in [0, nThreads), zero for the calling one, e.g. to collect results per thread.
+     * Returns when all tasks are done. */
+    void runInParallel(size_t nTasks, unsigned nThreads,
+            const std::function<void(size_t task, unsigned thread)>& task);
+}
+
+#endif
@@ -3,14 +3,12 @@
     #include <stdio.h>
     #include <string.h>
     #include "parseradapter.h"
-
-    int yylex(void);
-    int foundSyntaxError;
-    void yyerror(char *message);
-    void *result;
-    extern char yytext[];
 %}
 
+%define api.pure full
+%lex-param {void *scanner}
+%parse-param {void *scanner} {struct tsym_parserState *state}
+
 %token LONG LONG_TEXT
 %token DOUBLE
 %token SYMBOL
@@ -24,14 +22,21 @@
     char *stringVal;
     long longVal;
     double doubleVal;
-    void *basePtr;
+    unsigned expr;
 }
 
+%{
+    /* The parser is pure and the scanner reentrant, all state of a parsing run is passed in by the
+     * two parameters above. See scanner.l for details. */
+    int yylex(YYSTYPE *lvalp, void *scanner);
+    void yyerror(void *scanner, struct tsym_parserState *state, const char *message);
+%}
+
 %type <stringVal> SYMBOL LONG_TEXT
 %type <stringVal> DOUBLE_RANGE
 %type <doubleVal> DOUBLE
 %type <longVal> LONG
-%type <basePtr> parsedExpr expr function textual
+%type <expr> parsedExpr expr function textual
 
 %left '+' '-'
 %left '*' '/'
@@ -43,120 +48,108 @@
 %%
 
 parsedExpr: expr {
-        result = $1;
+        state->result = $1;
     }
     ;
 
 expr: function
     | textual
     | DOUBLE_RANGE {
-        tsym_parserAdapter_logParsingError("Float out of representable range: ", $1);
-        result = $$ = tsym_parserAdapter_createMaxDouble("Continue with maximum double: ");
+        tsym_parserAdapter_logParsingError(state, "Float out of representable range: ", $1);
+        state->result = $$ = tsym_parserAdapter_createMaxDouble(state,
+                "Continue with maximum double: ");
     }
     | LONG {
-        result = $$ = tsym_parserAdapter_createInteger($1);
+        state->result = $$ = tsym_parserAdapter_createInteger(state, $1);
     }
     | LONG_TEXT {
-        result = $$ = tsym_parserAdapter_createLongInteger($1);
+        state->result = $$ = tsym_parserAdapter_createLongInteger(state, $1);
     }
     | DOUBLE {
-        result = $$ = tsym_parserAdapter_createDouble($1);
+        state->result = $$ = tsym_parserAdapter_createDouble(state, $1);
     }
     | expr '+' expr {
-        result = $$ = tsym_parserAdapter_createSum($1, $3);
-        tsym_parserAdapter_deletePtrs($1, $3);
+        state->result = $$ = tsym_parserAdapter_createSum(state, $1, $3);
     }
     | expr '-' expr {
-        result = $$ = tsym_parserAdapter_createDifference($1, $3);
-        tsym_parserAdapter_deletePtrs($1, $3);
+        state->result = $$ = tsym_parserAdapter_createDifference(state, $1, $3);
     }
     | expr '*' expr {
-        result = $$ = tsym_parserAdapter_createProduct($1, $3);
-        tsym_parserAdapter_deletePtrs($1, $3);
+        state->result = $$ = tsym_parserAdapter_createProduct(state, $1, $3);
     }
     | expr '/' expr {
-        result = $$ = tsym_parserAdapter_createQuotient($1, $3);
-        tsym_parserAdapter_deletePtrs($1, $3);
+        state->result = $$ = tsym_parserAdapter_createQuotient(state, $1, $3);
     }
     | '+' expr %prec UNARY {
-        result = $$ = $2;
+        state->result = $$ = $2;
     }
     | '-' expr %prec UNARY {
-        result = $$ = tsym_parserAdapter_createMinus($2);
-        tsym_parserAdapter_deletePtr($2);
+        state->result = $$ = tsym_parserAdapter_createMinus(state, $2);
     }
     | expr '^' expr {
-        result = $$ = tsym_parserAdapter_createPower($1, $3);
-        tsym_parserAdapter_deletePtrs($1, $3);
+        state->result = $$ = tsym_parserAdapter_createPower(state, $1, $3);
     }
     | '(' expr ')' {
-        result = $$ = $2;
+        state->result = $$ = $2;
     }
     ;
 
 textual: SYMBOL {
-        result = $$ = tsym_parserAdapter_createSymbol($1);
+        state->result = $$ = tsym_parserAdapter_createSymbol(state, $1);
     }
     | PI {
-        result = $$ = tsym_parserAdapter_createPi();
+        state->result = $$ = tsym_parserAdapter_createPi(state);
     }
     | EULER {
-        result = $$ = tsym_parserAdapter_createEuler();
+        state->result = $$ = tsym_parserAdapter_createEuler(state);
     }
     ;
 
 function: SIN '(' expr ')' {
-        result = $$ = tsym_parserAdapter_createSine($3);
-        tsym_parserAdapter_deletePtr($3);
+        state->result = $$ = tsym_parserAdapter_createSine(state, $3);
     }
     | COS '(' expr ')' {
-        result = $$ = tsym_parserAdapter_createCosine($3);
-        tsym_parserAdapter_deletePtr($3);
+        state->result = $$ = tsym_parserAdapter_createCosine(state, $3);
     }
     | TAN '(' expr ')' {
-        result = $$ = tsym_parserAdapter_createTangent($3);
-        tsym_parserAdapter_deletePtr($3);
+        state->result = $$ = tsym_parserAdapter_createTangent(state, $3);
     }
     | ASIN '(' expr ')' {
-        result = $$ = tsym_parserAdapter_createAsine($3);
-        tsym_parserAdapter_deletePtr($3);
+        state->result = $$ = tsym_parserAdapter_createAsine(state, $3);
     }
     | ACOS '(' expr ')' {
-        result = $$ = tsym_parserAdapter_createAcosine($3);
-        tsym_parserAdapter_deletePtr($3);
+        state->result = $$ = tsym_parserAdapter_createAcosine(state, $3);
     }
     | ATAN '(' expr ')' {
-        result = $$ = tsym_parserAdapter_createAtangent($3);
-        tsym_parserAdapter_deletePtr($3);
+        state->result = $$ = tsym_parserAdapter_createAtangent(state, $3);
     }
     | ATAN2 '(' expr ',' expr ')' {
-        result = $$ = tsym_parserAdapter_createAtangent2($3, $5);
-        tsym_parserAdapter_deletePtr($3);
-        tsym_parserAdapter_deletePtr($5);
+        state->result = $$ = tsym_parserAdapter_createAtangent2(state, $3, $5);
     }
     | LOG '(' expr ')' {
-        result = $$ = tsym_parserAdapter_createLogarithm($3);
-        tsym_parserAdapter_deletePtr($3);
+        state->result = $$ = tsym_parserAdapter_createLogarithm(state, $3);
     }
     | SQRT '(' expr ')' {
-        result = $$ = tsym_parserAdapter_createSquareRoot($3);
-        tsym_parserAdapter_deletePtr($3);
+        state->result = $$ = tsym_parserAdapter_createSquareRoot(state, $3);
     }
     | textual '(' expr ')' {
-        foundSyntaxError = 1;
-        tsym_parserAdapter_logParsingError("Unknown function, treated as variable!", "");
-        tsym_parserAdapter_deletePtr($3);
+        state->foundSyntaxError = 1;
+        tsym_parserAdapter_logParsingError(state, "Unknown function, treated as variable!", "");
+        tsym_parserAdapter_release(state, $3);
+        state->result = $$ = $1;
     }
     ;
 
 %%
 
-void yyerror(char *s)
+void yyerror(void *scanner, struct tsym_parserState *state, const char *s)
 {
-    foundSyntaxError = 1;
+    (void)scanner;
+
+    state->foundSyntaxError = 1;
 
     if (strcmp(s, "syntax error") != 0)
-        tsym_parserAdapter_logParsingError(s, yylval.stringVal);
+        tsym_parserAdapter_logParsingError(state, s, "");
     else
-        tsym_parserAdapter_logParsingError("Yacc: found syntax error", "");
+        tsym_parserAdapter_logParsingError(state, "Yacc: found syntax error", "");
 }
@@ -16,49 +16,200 @@
 #include "constant.h"
 #include "logging.h"
 
-/* These functions are defined in the (f)lex file scanner.l, see comment over there for details. */
-extern "C" void *parseString(const char *string);
-extern "C" unsigned getErrorColumn();
+/* This function is defined in the (f)lex file scanner.l, see comment over there for details. */
+extern "C" void tsym_parseString(const char *string, struct tsym_parserState *state);
 
 using namespace tsym;
 
 namespace {
-    void *toVoid(const BasePtr& basePtr)
+    class ValueStack {
+        /* Storage of the semantic values of one parsing run. The parser only deals with indices
+         * into this container, which are recycled as soon as a value has been consumed by an
+         * enclosing expression. Sums and products aren't created immediately, their operands are
+         * collected instead, such that long chains like a + b + c + ... are simplified in one
+         * step instead of nesting binary Sum::create calls with full simplification each. */
+        public:
+            ValueStack();
+
+            unsigned push(const BasePtr& expr);
+            unsigned appendSummand(unsigned sum, const BasePtr& summand);
+            unsigned appendFactor(unsigned product, const BasePtr& factor);
+            unsigned mergeSum(unsigned summand1, unsigned summand2);
+            unsigned mergeProduct(unsigned factor1, unsigned factor2);
+            /* Consumes the entry at the given index: */
+            BasePtr pop(unsigned index);
+            void release(unsigned index);
+            BasePtr result(unsigned index);
+
+        private:
+            enum Kind { EXPRESSION, SUM, PRODUCT };
+            struct Entry {
+                Kind kind;
+                BasePtr expr;
+                BasePtrList operands;
+            };
+
+            unsigned newEntry(Kind kind);
+            unsigned append(Kind kind, unsigned index, const BasePtr& operand);
+            unsigned merge(Kind kind, unsigned index1, unsigned index2);
+            const BasePtr& finalize(unsigned index);
+
+            std::vector<Entry> entries;
+            std::vector<unsigned> unused;
+    };
+
+    ValueStack::ValueStack() :
+        entries(1)
     {
-        return reinterpret_cast<void*>(new BasePtr(basePtr));
+        /* The first entry is reserved for the case that parsing doesn't create any expression. */
+        entries.front().kind = EXPRESSION;
+        entries.front().expr = Undefined::create();
     }
 
-    const BasePtr *fromVoid(const void *basePtr)
+    unsigned ValueStack::push(const BasePtr& expr)
     {
-        return reinterpret_cast<const BasePtr*>(basePtr);
+        const unsigned index = newEntry(EXPRESSION);
+
+        entries[index].expr = expr;
+
+        return index;
     }
 
-    BasePtr castNonZeroParseResult(const void *result)
+    unsigned ValueStack::newEntry(Kind kind)
     {
-        const BasePtr *castedResult(fromVoid(result));
-        const BasePtr copy(*castedResult);
+        unsigned index;
+
+        if (unused.empty()) {
+            index = static_cast<unsigned>(entries.size());
+            entries.push_back(Entry());
+        } else {
+            index = unused.back();
+            unused.pop_back();
+        }
 
-        delete castedResult;
+        entries[index].kind = kind;
+
+        return index;
+    }
+
+    unsigned ValueStack::appendSummand(unsigned sum, const BasePtr& summand)
+    {
+        return append(SUM, sum, summand);
+    }
 
-        return copy;
+    unsigned ValueStack::appendFactor(unsigned product, const BasePtr& factor)
+    {
+        return append(PRODUCT, product, factor);
     }
 
-    void *create(BasePtr (*fct)(const BasePtr& operand), const void *operand)
+    unsigned ValueStack::append(Kind kind, unsigned index, const BasePtr& operand)
     {
-        const BasePtr *castedOperand(fromVoid(operand));
-        const BasePtr creation(fct(*castedOperand));
+        unsigned collected;
+
+        if (entries[index].kind == kind)
+            collected = index;
+        else {
+            collected = newEntry(kind);
+            entries[collected].operands.push_back(pop(index));
+        }
 
-        return toVoid(creation);
+        entries[collected].operands.push_back(operand);
+
+        return collected;
     }
 
-    void *create(BasePtr (*fct)(const BasePtr& operand1, const BasePtr& operand2),
-            const void *operand1, const void *operand2)
+    unsigned ValueStack::mergeSum(unsigned summand1, unsigned summand2)
     {
-        const BasePtr *castedOperand1(fromVoid(operand1));
-        const BasePtr *castedOperand2(fromVoid(operand2));
-        const BasePtr creation(fct(*castedOperand1, *castedOperand2));
+        return merge(SUM, summand1, summand2);
+    }
 
-        return toVoid(creation);
+    unsigned ValueStack::mergeProduct(unsigned factor1, unsigned factor2)
+    {
+        return merge(PRODUCT, factor1, factor2);
+    }
+
+    unsigned ValueStack::merge(Kind kind, unsigned index1, unsigned index2)
+        /* Operands of a parenthesized sum (product) as the second argument of a sum (product)
+         * are spliced into the first one, the result would be flattened anyhow. */
+    {
+        unsigned collected;
+
+        if (entries[index2].kind != kind)
+            return append(kind, index1, pop(index2));
+
+        collected = append(kind, index1, entries[index2].operands.pop_front());
+
+        entries[collected].operands.insert(entries[collected].operands.end(),
+                entries[index2].operands.begin(), entries[index2].operands.end());
+
+        release(index2);
+
+        return collected;
+    }
+
+    BasePtr ValueStack::pop(unsigned index)
+    {
+        const BasePtr expr(finalize(index));
+
+        release(index);
+
+        return expr;
+    }
+
+    const BasePtr& ValueStack::finalize(unsigned index)
+    {
+        Entry& entry(entries[index]);
+
+        if (entry.kind == SUM)
+            entry.expr = Sum::create(entry.operands);
+        else if (entry.kind == PRODUCT)
+            entry.expr = Product::create(entry.operands);
+
+        entry.kind = EXPRESSION;
+        entry.operands.clear();
+
+        return entry.expr;
+    }
+
+    void ValueStack::release(unsigned index)
+    {
+        if (index == 0)
+            return;
+
+        entries[index].kind = EXPRESSION;
+        entries[index].expr = BasePtr();
+        entries[index].operands.clear();
+
+        unused.push_back(index);
+    }
+
+    BasePtr ValueStack::result(unsigned index)
+    {
+        return finalize(index);
+    }
+
+    ValueStack& values(struct tsym_parserState *state)
+    {
+        return *reinterpret_cast<ValueStack*>(state->values);
+    }
+
+    unsigned create(struct tsym_parserState *state, BasePtr (*fct)(const BasePtr& operand),
+            unsigned operand)
+    {
+        ValueStack& stack(values(state));
+
+        return stack.push(fct(stack.pop(operand)));
+    }
+
+    unsigned create(struct tsym_parserState *state,
+            BasePtr (*fct)(const BasePtr& operand1, const BasePtr& operand2), unsigned operand1,
+            unsigned operand2)
+    {
+        ValueStack& stack(values(state));
+        const BasePtr arg1(stack.pop(operand1));
+        const BasePtr arg2(stack.pop(operand2));
+
+        return stack.push(fct(arg1, arg2));
     }
 
     Name constructName(const std::string& orig)
@@ -79,213 +230,179 @@ namespace {
         return Name(orig.substr(0, underScorePos), subscript);
     }
 
-    std::vector<std::string>& errors()
+    void registerError(struct tsym_parserState *state, const std::string& message)
     {
-        static std::vector<std::string> errorVec;
+        std::vector<std::string> *errors(reinterpret_cast<std::vector<std::string>*>(
+                    state->errors));
 
-        return errorVec;
-    }
-
-    void registerError(const std::string& message)
-    {
         TSYM_ERROR(message);
 
-        errors().push_back(message);
+        errors->push_back(message);
     }
 }
 
-tsym::BasePtr tsym::parserAdapter::parse(const char *string)
+tsym::BasePtr tsym::parserAdapter::parse(const char *string, std::vector<std::string>& errors,
+        unsigned& firstErrorIndex)
 {
-    const void *parseResult = parseString(string);
+    struct tsym_parserState state;
+    const size_t nPreviousErrors = errors.size();
+    ValueStack stack;
 
-    if (parseResult == nullptr) {
-        TSYM_WARNING("Parsing \'%s\' resulted in null pointer", string);
-        return Undefined::create();
-    } else
-        return castNonZeroParseResult(parseResult);
-}
+    state.result = 0;
+    state.values = reinterpret_cast<void*>(&stack);
+    state.errors = reinterpret_cast<void*>(&errors);
+    state.foundSyntaxError = 0;
+    state.currentColumn = 0;
+    state.errorColumn = 0;
 
-void tsym::parserAdapter::clearErrors()
-{
-    /* Equivalent to call .clear() on the vector of error messages, but CppuTest then complains
-     * about a memory leak. This makes sure, that allocated data inside of the vector object is
-     * acutually deleted. */
-    std::vector<std::string>().swap(errors());
-}
+    tsym_parseString(string, &state);
 
-const std::vector<std::string>& tsym::parserAdapter::getErrors()
-{
-    return errors();
-}
+    firstErrorIndex = errors.size() == nPreviousErrors ? 0 : state.errorColumn - 1;
 
-unsigned tsym::parserAdapter::getFirstErrorIndex()
-{
-    if (errors().empty())
-        return 0;
-    else
-        return getErrorColumn() - 1;
+    if (state.result == 0)
+        TSYM_WARNING("Parsing \'%s\' didn't result in any expression", string);
+
+    return stack.result(state.result);
 }
 
-void *tsym_parserAdapter_createInteger(long value)
+unsigned tsym_parserAdapter_createInteger(struct tsym_parserState *state, long value)
 {
-    const BasePtr numeric(Numeric::create(Int(value)));
-
-    return toVoid(numeric);
+    return values(state).push(Numeric::create(Int(value)));
 }
 
-void *tsym_parserAdapter_createLongInteger(const char *value)
+unsigned tsym_parserAdapter_createLongInteger(struct tsym_parserState *state, const char *value)
 {
-    const BasePtr numeric(Numeric::create(Int(value)));
-
-    return toVoid(numeric);
+    return values(state).push(Numeric::create(Int(value)));
 }
 
-void *tsym_parserAdapter_createDouble(double value)
+unsigned tsym_parserAdapter_createDouble(struct tsym_parserState *state, double value)
 {
-    const BasePtr numeric(Numeric::create(value));
-
-    return toVoid(numeric);
+    return values(state).push(Numeric::create(value));
 }
 
-void *tsym_parserAdapter_createMaxDouble(const char *errorMessage)
+unsigned tsym_parserAdapter_createMaxDouble(struct tsym_parserState *state,
+        const char *errorMessage)
 {
     const BasePtr maxDouble(Numeric::create(std::numeric_limits<double>::max()));
 
     TSYM_ERROR(errorMessage, maxDouble);
 
-    return toVoid(maxDouble);
+    return values(state).push(maxDouble);
 }
 
-void *tsym_parserAdapter_createSymbol(const char *name)
+unsigned tsym_parserAdapter_createSymbol(struct tsym_parserState *state, const char *name)
 {
     const Name nameWithSubscript(constructName(name));
-    const BasePtr s(Symbol::create(nameWithSubscript));
 
-    return toVoid(s);
+    return values(state).push(Symbol::create(nameWithSubscript));
 }
 
-void *tsym_parserAdapter_createPi()
+unsigned tsym_parserAdapter_createPi(struct tsym_parserState *state)
 {
-    const BasePtr piConstant(Constant::createPi());
-
-    return toVoid(piConstant);
+    return values(state).push(Constant::createPi());
 }
 
-void *tsym_parserAdapter_createEuler()
+unsigned tsym_parserAdapter_createEuler(struct tsym_parserState *state)
 {
-    const BasePtr eulerConstant(Constant::createE());
-
-    return toVoid(eulerConstant);
+    return values(state).push(Constant::createE());
 }
 
-void *tsym_parserAdapter_createSum(const void *summand1, const void *summand2)
+unsigned tsym_parserAdapter_createSum(struct tsym_parserState *state, unsigned summand1,
+        unsigned summand2)
 {
-    return create(Sum::create, summand1, summand2);
+    return values(state).mergeSum(summand1, summand2);
 }
 
-void *tsym_parserAdapter_createDifference(const void *summand1, const void *summand2)
+unsigned tsym_parserAdapter_createDifference(struct tsym_parserState *state, unsigned summand1,
+        unsigned summand2)
 {
-    void *negativeSummand2(create(Product::minus, summand2));
-    void *result(create(Sum::create, summand1, negativeSummand2));
-
-    tsym_parserAdapter_deletePtr(negativeSummand2);
+    ValueStack& stack(values(state));
 
-    return result;
+    return stack.appendSummand(summand1, Product::minus(stack.pop(summand2)));
 }
 
-void *tsym_parserAdapter_createMinus(const void *arg)
+unsigned tsym_parserAdapter_createMinus(struct tsym_parserState *state, unsigned arg)
 {
-    return create(Product::minus, arg);
+    return create(state, Product::minus, arg);
 }
 
-void *tsym_parserAdapter_createProduct(const void *factor1, const void *factor2)
+unsigned tsym_parserAdapter_createProduct(struct tsym_parserState *state, unsigned factor1,
+        unsigned factor2)
 {
-    return create(Product::create, factor1, factor2);
+    return values(state).mergeProduct(factor1, factor2);
 }
 
-void *tsym_parserAdapter_createQuotient(const void *dividend, const void *divisor)
+unsigned tsym_parserAdapter_createQuotient(struct tsym_parserState *state, unsigned dividend,
+        unsigned divisor)
 {
-    void *divisorAsFactor(create(Power::oneOver, divisor));
-    void *result(create(Product::create, dividend, divisorAsFactor));
-
-    tsym_parserAdapter_deletePtr(divisorAsFactor);
+    ValueStack& stack(values(state));
 
-    return result;
+    return stack.appendFactor(dividend, Power::oneOver(stack.pop(divisor)));
 }
 
-void *tsym_parserAdapter_createPower(const void *base, const void *exponent)
+unsigned tsym_parserAdapter_createPower(struct tsym_parserState *state, unsigned base,
+        unsigned exponent)
 {
-    return create(Power::create, base, exponent);
+    return create(state, Power::create, base, exponent);
 }
 
-void *tsym_parserAdapter_createSine(const void *arg)
+unsigned tsym_parserAdapter_createSine(struct tsym_parserState *state, unsigned arg)
 {
-    return create(Trigonometric::createSin, arg);
+    return create(state, Trigonometric::createSin, arg);
 }
 
-void *tsym_parserAdapter_createCosine(const void *arg)
+unsigned tsym_parserAdapter_createCosine(struct tsym_parserState *state, unsigned arg)
 {
-    return create(Trigonometric::createCos, arg);
+    return create(state, Trigonometric::createCos, arg);
 }
 
-void *tsym_parserAdapter_createTangent(const void *arg)
+unsigned tsym_parserAdapter_createTangent(struct tsym_parserState *state, unsigned arg)
 {
-    return create(Trigonometric::createTan, arg);
+    return create(state, Trigonometric::createTan, arg);
 }
 
-void *tsym_parserAdapter_createAsine(const void *arg)
+unsigned tsym_parserAdapter_createAsine(struct tsym_parserState *state, unsigned arg)
 {
-    return create(Trigonometric::createAsin, arg);
+    return create(state, Trigonometric::createAsin, arg);
 }
 
-void *tsym_parserAdapter_createAcosine(const void *arg)
+unsigned tsym_parserAdapter_createAcosine(struct tsym_parserState *state, unsigned arg)
 {
-    return create(Trigonometric::createAcos, arg);
+    return create(state, Trigonometric::createAcos, arg);
 }
 
-void *tsym_parserAdapter_createAtangent(const void *arg)
+unsigned tsym_parserAdapter_createAtangent(struct tsym_parserState *state, unsigned arg)
 {
-    return create(Trigonometric::createAtan, arg);
+    return create(state, Trigonometric::createAtan, arg);
 }
 
-void *tsym_parserAdapter_createAtangent2(const void *arg1, const void *arg2)
+unsigned tsym_parserAdapter_createAtangent2(struct tsym_parserState *state, unsigned arg1,
+        unsigned arg2)
 {
-    const BasePtr *castedArg1(fromVoid(arg1));
-    const BasePtr *castedArg2(fromVoid(arg2));
-
-    return toVoid(Trigonometric::createAtan2(*castedArg1, *castedArg2));
+    return create(state, Trigonometric::createAtan2, arg1, arg2);
 }
 
-void *tsym_parserAdapter_createLogarithm(const void *arg)
+unsigned tsym_parserAdapter_createLogarithm(struct tsym_parserState *state, unsigned arg)
 {
-    return create(Logarithm::create, arg);
+    return create(state, Logarithm::create, arg);
 }
 
-void *tsym_parserAdapter_createSquareRoot(const void *arg)
+unsigned tsym_parserAdapter_createSquareRoot(struct tsym_parserState *state, unsigned arg)
 {
-    return create(Power::sqrt, arg);
+    return create(state, Power::sqrt, arg);
 }
 
-void tsym_parserAdapter_deletePtrs(void *ptr1, void *ptr2)
+void tsym_parserAdapter_release(struct tsym_parserState *state, unsigned index)
 {
-    tsym_parserAdapter_deletePtr(ptr1);
-    tsym_parserAdapter_deletePtr(ptr2);
-}
-
-void tsym_parserAdapter_deletePtr(void *ptr)
-{
-    BasePtr *casted(reinterpret_cast<BasePtr*>(ptr));
-
-    delete casted;
-
-    ptr = nullptr;
+    values(state).release(index);
 }
 
-void tsym_parserAdapter_logParsingError(const char *message, char *yytext)
+void tsym_parserAdapter_logParsingError(struct tsym_parserState *state, const char *message,
+        const char *yytext)
 {
     std::string errorMessage(message);
 
     errorMessage.append(yytext);
 
-    registerError(errorMessage);
+    registerError(state, errorMessage);
 }
@@ -2,52 +2,77 @@
 #define TSYM_PARSERADAPTER_H
 
 #ifdef __cplusplus
+#include <vector>
+#include <string>
 #include "baseptr.h"
 
 namespace tsym {
     namespace parserAdapter {
-        /* Functions that interface the C code generated for parsing and lexical analysis. They will
-         * be called from C++ parts only. */
-        BasePtr parse(const char *string);
-        void clearErrors();
-        const std::vector<std::string>& getErrors();
-        /* Returns 0, if no errors are encountered: */
-        unsigned getFirstErrorIndex();
+        /* Function that interfaces the C code generated for parsing and lexical analysis. It will
+         * be called from C++ parts only. Error messages are appended to the given vector, the
+         * index of the first erroneous character is set to 0 if no errors are encountered. All
+         * state is local to one call, such that parsing can be done in parallel. */
+        BasePtr parse(const char *string, std::vector<std::string>& errors,
+                unsigned& firstErrorIndex);
     }
 }
 
 extern "C" {
 #endif
 
-    /* Functions to create and delete expressions from primitives or other expressions and to
-     * register errors for use within the C++ code. These functions are called by the parser in
-     * order to handle its internal stack within pure C code (thus, evil void* pointer instead of
-     * the underlying C++ objects of type BasePtr). */
-    void *tsym_parserAdapter_createInteger(long value);
-    void *tsym_parserAdapter_createLongInteger(const char *value);
-    void *tsym_parserAdapter_createDouble(double value);
-    void *tsym_parserAdapter_createMaxDouble(const char *errorMessage);
-    void *tsym_parserAdapter_createSymbol(const char *name);
-    void *tsym_parserAdapter_createPi();
-    void *tsym_parserAdapter_createEuler();
-    void *tsym_parserAdapter_createSum(const void *summand1, const void *summand2);
-    void *tsym_parserAdapter_createDifference(const void *summand1, const void *summand2);
-    void *tsym_parserAdapter_createMinus(const void *arg);
-    void *tsym_parserAdapter_createProduct(const void *factor1, const void *factor2);
-    void *tsym_parserAdapter_createQuotient(const void *factor1, const void *factor2);
-    void *tsym_parserAdapter_createPower(const void *base, const void *exp);
-    void *tsym_parserAdapter_createSine(const void *arg);
-    void *tsym_parserAdapter_createCosine(const void *arg);
-    void *tsym_parserAdapter_createTangent(const void *arg);
-    void *tsym_parserAdapter_createAsine(const void *arg);
-    void *tsym_parserAdapter_createAcosine(const void *arg);
-    void *tsym_parserAdapter_createAtangent(const void *arg);
-    void *tsym_parserAdapter_createAtangent2(const void *arg1, const void *arg2);
-    void *tsym_parserAdapter_createLogarithm(const void *arg);
-    void *tsym_parserAdapter_createSquareRoot(const void *arg);
-    void tsym_parserAdapter_deletePtrs(void *ptr1, void *ptr2);
-    void tsym_parserAdapter_deletePtr(void *ptr);
-    void tsym_parserAdapter_logParsingError(const char *message, char *yytext);
+    /* State of one parsing run, shared by the reentrant scanner and the pure parser: */
+    struct tsym_parserState {
+        /* Index of the expression created last. If parsing succeeds, this is the result. Index
+         * zero is reserved and refers to an Undefined expression: */
+        unsigned result;
+        /* Semantic values of the parser, pointer to a value stack owned by parserAdapter::parse: */
+        void *values;
+        /* Error messages, pointer to a std::vector<std::string> owned by the caller: */
+        void *errors;
+        int foundSyntaxError;
+        unsigned currentColumn;
+        unsigned errorColumn;
+    };
+
+    /* Functions to create expressions from primitives or other expressions and to register errors
+     * for use within the C++ code. These functions are called by the parser, which handles its
+     * internal stack within pure C code. Expressions are thus referred to by an index into the
+     * value stack of the given state. An index passed as an argument is consumed, i.e., it must
+     * not be used again after the call. Sums and products are collected and simplified in one
+     * step when their value is requested by an enclosing expression or as the final result. */
+    unsigned tsym_parserAdapter_createInteger(struct tsym_parserState *state, long value);
+    unsigned tsym_parserAdapter_createLongInteger(struct tsym_parserState *state,
+            const char *value);
+    unsigned tsym_parserAdapter_createDouble(struct tsym_parserState *state, double value);
+    unsigned tsym_parserAdapter_createMaxDouble(struct tsym_parserState *state,
+            const char *errorMessage);
+    unsigned tsym_parserAdapter_createSymbol(struct tsym_parserState *state, const char *name);
+    unsigned tsym_parserAdapter_createPi(struct tsym_parserState *state);
+    unsigned tsym_parserAdapter_createEuler(struct tsym_parserState *state);
+    unsigned tsym_parserAdapter_createSum(struct tsym_parserState *state, unsigned summand1,
+            unsigned summand2);
+    unsigned tsym_parserAdapter_createDifference(struct tsym_parserState *state,
+            unsigned summand1, unsigned summand2);
+    unsigned tsym_parserAdapter_createMinus(struct tsym_parserState *state, unsigned arg);
+    unsigned tsym_parserAdapter_createProduct(struct tsym_parserState *state, unsigned factor1,
+            unsigned factor2);
+    unsigned tsym_parserAdapter_createQuotient(struct tsym_parserState *state, unsigned dividend,
+            unsigned divisor);
+    unsigned tsym_parserAdapter_createPower(struct tsym_parserState *state, unsigned base,
+            unsigned exp);
+    unsigned tsym_parserAdapter_createSine(struct tsym_parserState *state, unsigned arg);
+    unsigned tsym_parserAdapter_createCosine(struct tsym_parserState *state, unsigned arg);
+    unsigned tsym_parserAdapter_createTangent(struct tsym_parserState *state, unsigned arg);
+    unsigned tsym_parserAdapter_createAsine(struct tsym_parserState *state, unsigned arg);
+    unsigned tsym_parserAdapter_createAcosine(struct tsym_parserState *state, unsigned arg);
+    unsigned tsym_parserAdapter_createAtangent(struct tsym_parserState *state, unsigned arg);
+    unsigned tsym_parserAdapter_createAtangent2(struct tsym_parserState *state, unsigned arg1,
+            unsigned arg2);
+    unsigned tsym_parserAdapter_createLogarithm(struct tsym_parserState *state, unsigned arg);
+    unsigned tsym_parserAdapter_createSquareRoot(struct tsym_parserState *state, unsigned arg);
+    void tsym_parserAdapter_release(struct tsym_parserState *state, unsigned index);
+    void tsym_parserAdapter_logParsingError(struct tsym_parserState *state, const char *message,
+            const char *yytext);
 
 #ifdef __cplusplus
 }
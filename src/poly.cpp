@@ -7,9 +7,13 @@
 #include "sum.h"
 #include "logging.h"
 #include "polyinfo.h"
+#include "sparsepoly.h"
+#include "densepoly.h"
 #include "primitivegcd.h"
-#include "subresultantgcd.h"
+#include "modulargcd.h"
 #include "cache.h"
+#include "context.h"
+#include "contextdata.h"
 
 namespace tsym {
     static BasePtrList divideEmptyList(const BasePtr& u, const BasePtr& v);
@@ -18,12 +22,16 @@ namespace tsym {
             bool computeQuotient);
     static BasePtrList pseudoDivideChecked(const BasePtr& u, const BasePtr& v, const BasePtr& x,
             bool computeQuotient);
+    static void pseudoDivideDense(const SparsePoly& u, const SparsePoly& v, SparsePoly& quotient,
+            SparsePoly& remainder, bool computeQuotient);
     static int unitFromNonNumeric(const BasePtr& polynomial);
     static BasePtr getFirstSymbol(const BasePtr& polynomial);
     static BasePtr getFirstSymbol(const BasePtrList& polynomials);
     static const GcdStrategy *defaultGcd();
     static BasePtr nonTrivialContent(const BasePtr& expandedPolynomial, const BasePtr& x,
             const GcdStrategy *algo);
+    static BasePtr nonTrivialContent(const SparsePoly& polynomial, const BasePtrList& variables,
+            const GcdStrategy *algo);
     static int minDegreeOfPower(const BasePtr& power, const tsym::BasePtr& variable);
     static int minDegreeOfSum(const BasePtr& sum, const tsym::BasePtr& variable);
     static int minDegreeOfProduct(const BasePtr& product, const tsym::BasePtr& variable);
@@ -31,7 +39,7 @@ namespace tsym {
 
 tsym::BasePtrList tsym::poly::divide(const BasePtr& u, const BasePtr& v)
 {
-    static Cache<BasePtrList, BasePtrList> cache;
+    Cache<BasePtrList, BasePtrList>& cache(Context::current().data().divideCache);
     const BasePtrList *cached(cache.retrieve({ u, v }));
     BasePtrList result;
 
@@ -75,40 +83,38 @@ tsym::BasePtrList tsym::divideEmptyList(const tsym::BasePtr& u, const tsym::Base
 }
 
 tsym::BasePtrList tsym::divideNonEmpty(const BasePtr& u, const BasePtr& v, const BasePtrList& L)
-    /* The central part of the algorithm described in Cohen [2003]. */
+    /* The central part of the algorithm described in Cohen [2003], carried out on the sparse
+     * representation with the variables of L first. */
 {
-    const BasePtr& x(L.front());
-    BasePtr quotient(Numeric::zero());
-    BasePtr remainder(u);
-    int m = u->degree(x);
-    int n = v->degree(x);
-    BasePtrList d;
-    BasePtr tmp;
-    BasePtr c;
-
-    assert(x->isSymbol());
-
-    while (m >= n) {
-        assert(m >= 0 && n >= 0);
-
-        d = poly::divide(remainder->leadingCoeff(x), v->leadingCoeff(x), L.rest());
-
-        if (!d.back()->isZero())
-            return BasePtrList(quotient->expand(), remainder);
-
-        c = d.front();
-        tmp = Power::create(x, Numeric::create(m - n));
-        quotient = Sum::create(quotient, Product::create(c, tmp));
-
-        remainder = Sum::create(remainder, Product::minus(c, v, tmp))->expand();
-
-        if (remainder->isZero())
-            break;
-
-        m = remainder->degree(x);
-    }
+    const BasePtrList variables(SparsePoly::variables(L, u, v));
+    SparsePoly quotient;
+    SparsePoly remainder;
+    SparsePoly sparseU;
+    SparsePoly sparseV;
+    DensePoly denseQuotient;
+    DensePoly denseRemainder;
+    DensePoly denseU;
+    DensePoly denseV;
+
+    assert(L.front()->isSymbol());
+
+    if (!SparsePoly::fromBasePtr(u, variables, sparseU) ||
+            !SparsePoly::fromBasePtr(v, variables, sparseV)) {
+        TSYM_ERROR("Conversion of ", u, " or ", v, " to a sparse polynomial failed! Return "
+                "quotient and remainder as Undefined.");
+        return BasePtrList(Undefined::create(), Undefined::create());
+    } else if (variables.size() == 1 && !sparseV.isZero() &&
+            DensePoly::fromSparse(sparseU, denseU) && DensePoly::fromSparse(sparseV, denseV)) {
+        denseU.divide(denseV, denseQuotient, denseRemainder);
+        quotient = denseQuotient.toSparse(1);
+        remainder = denseRemainder.toSparse(1);
+    } else
+        sparseU.divide(sparseV, 0, L.size(), quotient, remainder);
 
-    return BasePtrList(quotient->expand(), remainder);
+    if (quotient.isZero())
+        return BasePtrList(Numeric::zero(), u);
+    else
+        return BasePtrList(quotient.toBasePtr(variables), remainder.toBasePtr(variables));
 }
 
 tsym::BasePtrList tsym::poly::pseudoDivide(const BasePtr& u, const BasePtr& v, const BasePtr& x)
@@ -134,41 +140,50 @@ tsym::BasePtrList tsym::pseudoDivide(const BasePtr& u, const BasePtr& v, const B
 tsym::BasePtrList tsym::pseudoDivideChecked(const BasePtr& u, const BasePtr& v, const BasePtr& x,
         bool computeQuotient)
 {
-    const BasePtr lCoeffV(v->leadingCoeff(x));
-    const int n = v->degree(x);
-    BasePtr quotient(Numeric::zero());
-    BasePtr remainder(u->expand());
-    BasePtr lCoeffR;
-    BasePtr tmp;
-    int m = u->degree(x);
-    int sigma = 0;
-
-    assert(!v->expand()->isZero());
-
-    while (m >= n) {
-        lCoeffR = remainder->coeff(x, m);
-
-        tmp = Product::create(lCoeffR, Power::create(x, Numeric::create(m - n)));
+    const BasePtrList variables(SparsePoly::variables(BasePtrList(x), u, v));
+    SparsePoly quotient;
+    SparsePoly remainder;
+    SparsePoly sparseU;
+    SparsePoly sparseV;
+
+    if (!SparsePoly::fromBasePtr(u, variables, sparseU) ||
+            !SparsePoly::fromBasePtr(v, variables, sparseV)) {
+        TSYM_ERROR("Conversion of ", u, " or ", v, " to a sparse polynomial failed! Return "
+                "pseudo-quotient and -remainder as Undefined.");
+        return BasePtrList(Undefined::create(), Undefined::create());
+    }
 
-        if (computeQuotient)
-            quotient = Sum::create(Product::create(lCoeffV, quotient), tmp);
+    assert(!sparseV.isZero());
 
-        remainder = Sum::create(Product::create(lCoeffV, remainder),
-                Product::minus(v, tmp))->expand();
+    if (variables.size() == 1)
+        pseudoDivideDense(sparseU, sparseV, quotient, remainder, computeQuotient);
+    else if (computeQuotient)
+        sparseU.pseudoDivide(sparseV, 0, quotient, remainder);
+    else
+        remainder = sparseU.pseudoRemainder(sparseV, 0);
 
-        if (remainder->isZero())
-            break;
+    return BasePtrList(quotient.toBasePtr(variables), remainder.toBasePtr(variables));
+}
 
-        ++sigma;
-        m = remainder->degree(x);
-    }
+void tsym::pseudoDivideDense(const SparsePoly& u, const SparsePoly& v, SparsePoly& quotient,
+        SparsePoly& remainder, bool computeQuotient)
+    /* Univariate polynomials are processed in the dense representation. */
+{
+    DensePoly denseQuotient;
+    DensePoly denseRemainder;
+    DensePoly denseU;
+    DensePoly denseV;
 
-    tmp = Power::create(lCoeffV, Numeric::create(std::max(u->degree(x) - n + 1, 0) - sigma));
+    DensePoly::fromSparse(u, denseU);
+    DensePoly::fromSparse(v, denseV);
 
-    remainder = Product::create(tmp, remainder)->expand();
-    quotient = computeQuotient ? Product::create(tmp, quotient)->expand() : Numeric::zero();
+    if (computeQuotient)
+        denseU.pseudoDivide(denseV, denseQuotient, denseRemainder);
+    else
+        denseRemainder = denseU.pseudoRemainder(denseV);
 
-    return BasePtrList(quotient, remainder);
+    quotient = denseQuotient.toSparse(1);
+    remainder = denseRemainder.toSparse(1);
 }
 
 tsym::BasePtr tsym::poly::pseudoRemainder(const BasePtr& u, const BasePtr& v, const BasePtr& x)
@@ -229,7 +244,7 @@ tsym::BasePtr tsym::getFirstSymbol(const BasePtrList& polynomials)
 
 tsym::BasePtr tsym::poly::gcd(const BasePtr& u, const BasePtr& v)
 {
-    static Cache<BasePtrList, BasePtr> cache;
+    Cache<BasePtrList, BasePtr>& cache(Context::current().data().gcdCache);
     const BasePtr *cached(cache.retrieve({ u, v }));
 
     if (cached != nullptr)
@@ -240,7 +255,7 @@ tsym::BasePtr tsym::poly::gcd(const BasePtr& u, const BasePtr& v)
 
 const tsym::GcdStrategy *tsym::defaultGcd()
 {
-    static SubresultantGcd algo;
+    static ModularGcd algo;
 
     return &algo;
 }
@@ -258,17 +273,21 @@ tsym::BasePtr tsym::poly::content(const BasePtr& polynomial, const tsym::BasePtr
 tsym::BasePtr tsym::poly::content(const BasePtr& polynomial, const tsym::BasePtr& x,
         const GcdStrategy *algo)
 {
-    const BasePtr expanded(polynomial->expand());
+    const BasePtrList variables(SparsePoly::variables(BasePtrList(x), polynomial, polynomial));
+    SparsePoly sparse;
 
-    if (expanded->isNumeric())
+    if (!SparsePoly::fromBasePtr(polynomial, variables, sparse))
+        return nonTrivialContent(polynomial->expand(), x, algo);
+    else if (sparse.isConstant())
         /* This include the zero case. */
-        return Numeric::create(expanded->numericEval().abs());
+        return Numeric::create(sparse.constant().abs());
     else
-        return nonTrivialContent(expanded, x, algo);
+        return nonTrivialContent(sparse, variables, algo);
 }
 
 tsym::BasePtr tsym::nonTrivialContent(const BasePtr& expandedPolynomial, const BasePtr& x,
         const GcdStrategy *algo)
+    /* Fallback for input that isn't a polynomial in the first place. */
 {
     const int minDegree = poly::minDegree(expandedPolynomial, x);
     const int degree = expandedPolynomial->degree(x);
@@ -280,6 +299,19 @@ tsym::BasePtr tsym::nonTrivialContent(const BasePtr& expandedPolynomial, const B
     return content;
 }
 
+tsym::BasePtr tsym::nonTrivialContent(const SparsePoly& polynomial, const BasePtrList& variables,
+        const GcdStrategy *algo)
+{
+    const int minDegree = polynomial.minDegree(0);
+    const int degree = polynomial.degree(0);
+    BasePtr content(Numeric::zero());
+
+    for (int i = minDegree; i <= degree; ++i)
+        content = poly::gcd(polynomial.coeff(0, i).toBasePtr(variables), content, algo);
+
+    return content;
+}
+
 int tsym::poly::minDegree(const BasePtr& of, const BasePtr& variable)
 {
     if (!variable->isSymbol())
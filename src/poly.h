@@ -9,7 +9,8 @@ namespace tsym { class GcdStrategy; }
 namespace tsym {
     /* Functions for multivariate polynomial terms with rational number coefficients, symbolic
      * variables and positive integer exponents. All algorithms implemented here are described in
-     * Cohen [2003]. */
+     * Cohen [2003]. Division and content computation convert their arguments to the SparsePoly
+     * representation, such that intermediate results aren't simplified automatically. */
     namespace poly {
         /* Division u/v, where the divisor v is non-zero. The first of the returned list is the
          * quotient, the second the remainder. If the input is invalid, the quotient is Undefined,
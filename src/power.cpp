@@ -10,6 +10,46 @@
 #include "product.h"
 #include "sum.h"
 #include "powernormal.h"
+#include "cache.h"
+#include "context.h"
+#include "contextdata.h"
+#include "termcollector.h"
+
+namespace tsym {
+    namespace {
+        /* Number of terms of the multinomial theorem up to which sums are raised to an integer
+         * power by it: */
+        const Int maxMultinomialTerms(4096);
+
+        void addMultinomialTerms(BasePtrList::const_iterator summand,
+                BasePtrList::const_iterator end, const Int& remaining, const BasePtrList& factors,
+                TermCollector& collector)
+            /* Adds all terms of (s_i + ... + s_m)^remaining, each multiplied by the given factors.
+             * The multinomial coefficients are accumulated as products of binomial coefficients. */
+        {
+            const BasePtrList::const_iterator next(std::next(summand));
+            Int binomial(1);
+            BasePtr power;
+
+            if (next == end) {
+                power = Power::create(*summand, Numeric::create(remaining));
+                collector.add(Product::create(BasePtrList(factors, BasePtrList(power)))->expand());
+                return;
+            }
+
+            for (Int k(0); k <= remaining; ++k) {
+                if (k > 0)
+                    binomial = binomial*(remaining - k + 1)/k;
+
+                power = Power::create(*summand, Numeric::create(k));
+
+                addMultinomialTerms(next, end, remaining - k,
+                        BasePtrList(factors, BasePtrList(Numeric::create(binomial), power)),
+                        collector);
+            }
+        }
+    }
+}
 
 tsym::Power::Power(const BasePtr& base, const BasePtr& exponent) :
     Base(BasePtrList(base, exponent)),
@@ -17,8 +57,6 @@ tsym::Power::Power(const BasePtr& base, const BasePtr& exponent) :
     expRef(ops.back())
 {
     assert(ops.size() == 2);
-
-    setDebugString();
 }
 
 tsym::Power::~Power() {}
@@ -116,8 +154,8 @@ tsym::Fraction tsym::Power::normal(SymbolMap& map) const
 tsym::BasePtr tsym::Power::diffWrtSymbol(const BasePtr& symbol) const
 {
     const BasePtrList summands {
-        Product::create(Logarithm::create(baseRef), expRef->diffWrtSymbol(symbol)),
-            Product::create(expRef, oneOver(baseRef), baseRef->diffWrtSymbol(symbol))
+        Product::create(Logarithm::create(baseRef), expRef->diff(symbol)),
+            Product::create(expRef, oneOver(baseRef), baseRef->diff(symbol))
     };
 
     return Product::create(clone(), Sum::create(summands));
@@ -195,20 +233,53 @@ tsym::BasePtr tsym::Power::expandIntegerExponent() const
 }
 
 tsym::BasePtr tsym::Power::expandSumBaseIntExp() const
+    /* The expansion is cached as the one of a product with this power as the only factor, which
+     * is the same expression. */
 {
+    Cache<BasePtrList, BasePtr>& cache(Context::current().data().expandCache);
+    const BasePtrList key(clone());
+    const BasePtr *cached(cache.retrieve(key));
     const Int nExp(expRef->numericEval().numerator());
-    BasePtrList sums;
+    const BasePtr base(baseRef->expand());
     BasePtr res;
 
-    for (Int i(0); i < nExp.abs(); ++i)
-        sums.push_back(baseRef);
+    if (cached != nullptr)
+        return *cached;
 
-    res = sums.expandAsProduct();
+    if (base->isSum())
+        res = expandSum(base, nExp.abs());
+    else
+        res = Power::create(base, Numeric::create(nExp.abs()))->expand();
 
     if (nExp < 0)
         res = Power::oneOver(res);
 
-    return res;
+    return cache.insertAndReturn(key, res);
+}
+
+tsym::BasePtr tsym::Power::expandSum(const BasePtr& sum, const Int& exp) const
+    /* Uses the multinomial theorem, unless the number of its terms is large, which means that
+     * many of them will be collected again (e.g. for univariate polynomials). Then, repeated
+     * multiplication is cheaper, as the intermediate products are smaller. */
+{
+    const Int nSummands(static_cast<long>(sum->operands().size()));
+    Int nTerms(1);
+    TermCollector collector;
+    BasePtrList sums;
+
+    for (Int i(1); i < nSummands && nTerms <= maxMultinomialTerms; ++i)
+        nTerms = nTerms*(exp + i)/i;
+
+    if (nTerms <= maxMultinomialTerms) {
+        addMultinomialTerms(sum->operands().begin(), sum->operands().end(), exp,
+                BasePtrList(Numeric::one()), collector);
+        return collector.sum();
+    }
+
+    for (Int i(0); i < exp; ++i)
+        sums.push_back(sum);
+
+    return sums.expandAsProduct();
 }
 
 tsym::BasePtr tsym::Power::subst(const BasePtr& from, const BasePtr& to) const
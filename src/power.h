@@ -11,6 +11,8 @@ namespace tsym {
          * Symbolic Computation [2003] in some parts, but implements a special treatment of numeric
          * powers, e.g. (3/4)^(-1/2) = (4/3)^(1/2). */
         public:
+            friend class DagReader;
+
             static BasePtr create(const BasePtr& base, const BasePtr& exponent);
             static BasePtr oneOver(const BasePtr& base);
             static BasePtr sqrt(const BasePtr& base);
@@ -49,6 +51,7 @@ namespace tsym {
             bool isExponentRationalNumeric() const;
             BasePtr expandIntegerExponent() const;
             BasePtr expandSumBaseIntExp() const;
+            BasePtr expandSum(const BasePtr& sum, const Int& exp) const;
 
             const BasePtr& baseRef;
             const BasePtr& expRef;
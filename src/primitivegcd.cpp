@@ -3,35 +3,50 @@
 #include "poly.h"
 #include "product.h"
 #include "numeric.h"
+#include "sparsepoly.h"
 #include "logging.h"
 
 tsym::BasePtr tsym::PrimitiveGcd::gcdAlgo(const BasePtr& u, const BasePtr& v,
         const BasePtrList& L) const
+    /* The remainder sequence is computed on the sparse representation, contents are still
+     * computed recursively on Base objects. */
 {
     const BasePtr x(L.front());
     const BasePtrList R(L.rest());
+    const BasePtrList variables(SparsePoly::variables(L, u, v));
     const BasePtr uContent(poly::content(u, x, this));
     const BasePtr vContent(poly::content(v, x, this));
     const BasePtr d(compute(uContent, vContent, R));
-    BasePtr uPrimPart(poly::divide(u, uContent, L).front());
-    BasePtr vPrimPart(poly::divide(v, vContent, L).front());
-    BasePtr rPrimPart;
-    BasePtr remainder;
+    SparsePoly uPrimPart;
+    SparsePoly vPrimPart;
+    SparsePoly rPrimPart;
+    SparsePoly remainder;
+    SparsePoly content;
+    SparsePoly rest;
+    SparsePoly sparseD;
 
-    while (!vPrimPart->isZero()) {
-        remainder = poly::pseudoRemainder(uPrimPart, vPrimPart, x);
+    if (!SparsePoly::fromBasePtr(poly::divide(u, uContent, L).front(), variables, uPrimPart) ||
+            !SparsePoly::fromBasePtr(poly::divide(v, vContent, L).front(), variables, vPrimPart) ||
+            !SparsePoly::fromBasePtr(d, variables, sparseD)) {
+        TSYM_WARNING("Non-polynomial input during primitive gcd computation, return 1.");
+        return Numeric::one();
+    }
+
+    while (!vPrimPart.isZero()) {
+        remainder = uPrimPart.pseudoRemainder(vPrimPart, 0);
 
-        if (remainder->isZero())
-            rPrimPart = Numeric::zero();
-        else if (remainder->isUndefined()) {
-            TSYM_WARNING("Undefined remainder during primitive gcd computation, return 1.");
+        if (remainder.isZero())
+            rPrimPart = remainder;
+        else if (!SparsePoly::fromBasePtr(poly::content(remainder.toBasePtr(variables), x),
+                    variables, content)) {
+            TSYM_WARNING("Non-polynomial content during primitive gcd computation, return 1.");
             return Numeric::one();
         } else
-            rPrimPart = poly::divide(remainder, poly::content(remainder, x), L).front();
+            remainder.divide(content, 0, L.size(), rPrimPart, rest);
 
         uPrimPart = vPrimPart;
         vPrimPart = rPrimPart;
     }
 
-    return Product::create(d, uPrimPart)->expand();
+    return (sparseD*uPrimPart).toBasePtr(variables);
 }
@@ -8,12 +8,11 @@
 #include "power.h"
 #include "sum.h"
 #include "symbolmap.h"
+#include "zerotest.h"
 
 tsym::Product::Product(const BasePtrList& factors) :
     Base(factors)
-{
-    setDebugString();
-}
+{}
 
 tsym::Product::~Product() {}
 
@@ -124,7 +123,7 @@ tsym::Fraction tsym::Product::normal(SymbolMap& map) const
 {
     Fraction unCanceled;
 
-    if (expand()->isZero())
+    if (isZeroForNormal(clone()))
         return Fraction(Numeric::zero());
 
     unCanceled = normalAndSplitIntoFraction(map);
@@ -153,7 +152,7 @@ tsym::BasePtr tsym::Product::diffWrtSymbol(const BasePtr& symbol) const
     BasePtrList factors;
 
     for (auto it1 = ops.begin(); it1 != ops.end(); ++it1) {
-        factors.push_back((*it1)->diffWrtSymbol(symbol));
+        factors.push_back((*it1)->diff(symbol));
 
         for (auto it2 = ops.begin(); it2 != ops.end(); ++it2)
             if (it1 != it2)
@@ -6,6 +6,8 @@
 namespace tsym {
     class Product : public Base {
         public:
+            friend class DagReader;
+
             static BasePtr create(const BasePtr& f1, const BasePtr& f2);
             static BasePtr create(const BasePtr& f1, const BasePtr& f2, const BasePtr& f3);
             static BasePtr create(const BasePtr& f1, const BasePtr& f2, const BasePtr& f3,
@@ -0,0 +1,87 @@
+
+#include <fstream>
+#include "serialization.h"
+#include "dagwriter.h"
+#include "dagreader.h"
+#include "mappedfile.h"
+#include "undefined.h"
+#include "logging.h"
+
+std::string tsym::serialize(const Var& expr)
+{
+    const DagWriter writer(BasePtrList(expr.getBasePtr()));
+
+    return writer.get();
+}
+
+std::string tsym::serialize(const std::vector<Var>& expressions)
+{
+    BasePtrList roots;
+
+    for (const auto& expr : expressions)
+        roots.push_back(expr.getBasePtr());
+
+    const DagWriter writer(roots);
+
+    return writer.get();
+}
+
+tsym::Var tsym::deserialize(const std::string& data, bool *success)
+{
+    bool validData;
+    const std::vector<Var> expressions(deserializeAll(data.data(), data.size(), &validData));
+
+    if (validData && expressions.size() != 1) {
+        TSYM_ERROR("Binary data contains ", expressions.size(), " instead of one expression");
+        validData = false;
+    }
+
+    if (success != nullptr)
+        *success = validData;
+
+    return validData ? expressions.front() : Var(Undefined::create());
+}
+
+std::vector<tsym::Var> tsym::deserializeAll(const char *data, size_t length, bool *success)
+{
+    const DagReader reader(data, length);
+    std::vector<Var> expressions;
+
+    for (const auto& root : reader.getRoots())
+        expressions.push_back(Var(root));
+
+    if (success != nullptr)
+        *success = reader.success();
+
+    return expressions;
+}
+
+bool tsym::saveBinary(const std::string& filename, const std::vector<Var>& expressions)
+{
+    const std::string data(serialize(expressions));
+    std::ofstream stream(filename, std::ios::binary);
+
+    stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+
+    if (stream.good())
+        return true;
+
+    TSYM_ERROR("Couldn't write expressions to '", filename, "'");
+
+    return false;
+}
+
+std::vector<tsym::Var> tsym::loadBinary(const std::string& filename, bool *success)
+{
+    const MappedFile file(filename);
+
+    if (file.isValid())
+        return deserializeAll(file.begin(), file.length(), success);
+
+    TSYM_ERROR("Couldn't read expressions from '", filename, "'");
+
+    if (success != nullptr)
+        *success = false;
+
+    return std::vector<Var>();
+}
@@ -0,0 +1,27 @@
+#ifndef TSYM_SERIALIZATION_H
+#define TSYM_SERIALIZATION_H
+
+#include <string>
+#include <vector>
+#include "var.h"
+
+namespace tsym {
+    /* Versioned binary format for persisting expressions. Each distinct subexpression is stored
+     * once and referenced afterwards, numbers are stored as raw binary words, and loading restores
+     * the already simplified expressions without simplifying them again. Thus, large results can
+     * be cached on disk and loaded much faster than by printing and parsing them. Temporary
+     * symbols can't be serialized. Data of a different format version is rejected.
+     *
+     * Loading from a file memory-maps it and reads the expressions in place. All deserialization
+     * functions return an empty vector or an Undefined expression for invalid data, and set the
+     * optional success flag accordingly. */
+    std::string serialize(const Var& expr);
+    std::string serialize(const std::vector<Var>& expressions);
+    Var deserialize(const std::string& data, bool *success = nullptr);
+    std::vector<Var> deserializeAll(const char *data, size_t length, bool *success = nullptr);
+
+    bool saveBinary(const std::string& filename, const std::vector<Var>& expressions);
+    std::vector<Var> loadBinary(const std::string& filename, bool *success = nullptr);
+}
+
+#endif
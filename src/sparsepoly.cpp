@@ -0,0 +1,595 @@
+
+#include <cassert>
+#include <algorithm>
+#include "sparsepoly.h"
+#include "polyinfo.h"
+#include "numeric.h"
+#include "power.h"
+#include "product.h"
+#include "sum.h"
+#include "termcollector.h"
+
+tsym::SparsePoly::SparsePoly(size_t nVariables) :
+    nVars(nVariables)
+{}
+
+tsym::SparsePoly::SparsePoly(size_t nVariables, const Number& constant) :
+    nVars(nVariables)
+{
+    if (!constant.isZero())
+        rep.push_back({ Exponents(nVars, 0), constant });
+}
+
+tsym::SparsePoly::SparsePoly(size_t nVariables, std::vector<Term> terms) :
+    nVars(nVariables)
+{
+    sortAndCollect(terms);
+}
+
+bool tsym::SparsePoly::fromBasePtr(const BasePtr& ptr, const BasePtrList& variables,
+        SparsePoly& result)
+{
+    SparsePoly poly(variables.size());
+
+    if (ptr->isNumeric() && ptr->numericEval().isRational())
+        poly = SparsePoly(variables.size(), ptr->numericEval());
+    else if (!poly.fromBasePtrNonScalar(ptr, variables))
+        return false;
+
+    result = poly;
+
+    return true;
+}
+
+bool tsym::SparsePoly::fromBasePtrNonScalar(const BasePtr& ptr, const BasePtrList& variables)
+{
+    SparsePoly operand;
+
+    if (ptr->isSymbol())
+        return fromSymbol(ptr, variables);
+    else if (ptr->isPower())
+        return fromPower(ptr, variables);
+    else if (!ptr->isSum() && !ptr->isProduct())
+        return false;
+
+    *this = SparsePoly(nVars, ptr->isSum() ? 0 : 1);
+
+    for (const auto& item : ptr->operands()) {
+        if (!fromBasePtr(item, variables, operand))
+            return false;
+        else if (ptr->isSum())
+            *this += operand;
+        else
+            *this *= operand;
+    }
+
+    return true;
+}
+
+bool tsym::SparsePoly::fromSymbol(const BasePtr& symbol, const BasePtrList& variables)
+{
+    size_t index = 0;
+
+    for (const auto& variable : variables)
+        if (variable->isEqual(symbol))
+            break;
+        else
+            ++index;
+
+    if (index == nVars)
+        return false;
+
+    *this = SparsePoly(nVars, 1).timesPowerOf(index, 1);
+
+    return true;
+}
+
+bool tsym::SparsePoly::fromPower(const BasePtr& power, const BasePtrList& variables)
+{
+    const BasePtr exp(power->exp());
+    SparsePoly base;
+    Number n;
+
+    if (!exp->isNumeric())
+        return false;
+
+    n = exp->numericEval();
+
+    if (!n.isInt() || !n.numerator().fitsIntoInt() || n < 0)
+        return false;
+    else if (!fromBasePtr(power->base(), variables, base))
+        return false;
+
+    *this = base.toThe(static_cast<unsigned>(n.numerator().toInt()));
+
+    return true;
+}
+
+tsym::BasePtrList tsym::SparsePoly::variables(const BasePtrList& first, const BasePtr& u,
+        const BasePtr& v)
+{
+    PolyInfo polyInfo(u, v);
+    BasePtrList result(first);
+
+    for (const auto& symbol : polyInfo.listOfSymbols())
+        if (!result.has(symbol))
+            result.push_back(symbol);
+
+    return result;
+}
+
+tsym::BasePtr tsym::SparsePoly::toBasePtr(const BasePtrList& variables) const
+{
+    TermCollector collector;
+
+    assert(variables.size() == nVars);
+
+    if (rep.empty())
+        return Numeric::zero();
+
+    for (const auto& term : rep) {
+        BasePtrList factors(Numeric::create(term.coeff));
+        auto variable = variables.begin();
+
+        for (const unsigned exp : term.exp) {
+            if (exp == 1)
+                factors.push_back(*variable);
+            else if (exp > 1)
+                factors.push_back(Power::create(*variable, Numeric::create(static_cast<int>(exp))));
+
+            ++variable;
+        }
+
+        collector.add(Product::create(factors));
+    }
+
+    return collector.sum();
+}
+
+tsym::SparsePoly& tsym::SparsePoly::operator += (const SparsePoly& rhs)
+{
+    addOrSubtract(rhs, false);
+
+    return *this;
+}
+
+tsym::SparsePoly& tsym::SparsePoly::operator -= (const SparsePoly& rhs)
+{
+    addOrSubtract(rhs, true);
+
+    return *this;
+}
+
+void tsym::SparsePoly::addOrSubtract(const SparsePoly& rhs, bool subtract)
+    /* Merges the two sorted term arrays. */
+{
+    auto lhsIt = rep.cbegin();
+    auto rhsIt = rhs.rep.cbegin();
+    std::vector<Term> result;
+    Number coeff;
+
+    assert(nVars == rhs.nVars);
+
+    result.reserve(rep.size() + rhs.rep.size());
+
+    while (lhsIt != rep.cend() || rhsIt != rhs.rep.cend())
+        if (rhsIt == rhs.rep.cend() || (lhsIt != rep.cend() && isGreater(*lhsIt, *rhsIt)))
+            result.push_back(*lhsIt++);
+        else if (lhsIt == rep.cend() || isGreater(*rhsIt, *lhsIt)) {
+            result.push_back(*rhsIt++);
+
+            if (subtract)
+                result.back().coeff = -result.back().coeff;
+        } else {
+            coeff = subtract ? lhsIt->coeff - rhsIt->coeff : lhsIt->coeff + rhsIt->coeff;
+
+            if (!coeff.isZero())
+                result.push_back({ lhsIt->exp, coeff });
+
+            ++lhsIt;
+            ++rhsIt;
+        }
+
+    rep.swap(result);
+}
+
+tsym::SparsePoly& tsym::SparsePoly::operator *= (const SparsePoly& rhs)
+    /* All pairwise products are sorted and like terms are collected afterwards. */
+{
+    std::vector<Term> products;
+
+    assert(nVars == rhs.nVars);
+
+    products.reserve(rep.size()*rhs.rep.size());
+
+    for (const auto& lhsTerm : rep)
+        for (const auto& rhsTerm : rhs.rep) {
+            products.push_back({ lhsTerm.exp, lhsTerm.coeff*rhsTerm.coeff });
+
+            for (size_t i = 0; i < nVars; ++i)
+                products.back().exp[i] += rhsTerm.exp[i];
+        }
+
+    sortAndCollect(products);
+
+    return *this;
+}
+
+void tsym::SparsePoly::sortAndCollect(std::vector<Term>& terms)
+{
+    std::sort(terms.begin(), terms.end(), isGreater);
+
+    rep.clear();
+
+    for (const auto& term : terms)
+        if (!rep.empty() && rep.back().exp == term.exp)
+            rep.back().coeff += term.coeff;
+        else if (!rep.empty() && rep.back().coeff.isZero())
+            rep.back() = term;
+        else
+            rep.push_back(term);
+
+    if (!rep.empty() && rep.back().coeff.isZero())
+        rep.pop_back();
+}
+
+tsym::SparsePoly& tsym::SparsePoly::operator *= (const Number& rhs)
+{
+    if (rhs.isZero())
+        rep.clear();
+
+    for (auto& term : rep)
+        term.coeff *= rhs;
+
+    return *this;
+}
+
+tsym::SparsePoly tsym::SparsePoly::operator - () const
+{
+    return *this*Number(-1);
+}
+
+tsym::SparsePoly tsym::SparsePoly::toThe(unsigned exp) const
+    /* Exponentiation by squaring. */
+{
+    SparsePoly result(nVars, 1);
+    SparsePoly base(*this);
+
+    while (exp != 0) {
+        if (exp & 1u)
+            result *= base;
+
+        exp >>= 1;
+
+        if (exp != 0)
+            base *= base;
+    }
+
+    return result;
+}
+
+tsym::SparsePoly tsym::SparsePoly::timesPowerOf(size_t variable, unsigned exp) const
+    /* Adding the same exponent to every term doesn't change their order. */
+{
+    SparsePoly result(*this);
+
+    for (auto& term : result.rep)
+        term.exp[variable] += exp;
+
+    return result;
+}
+
+tsym::SparsePoly tsym::SparsePoly::evaluate(size_t variable, const Number& value) const
+{
+    std::vector<Number> powers(1, 1);
+    std::vector<Term> terms(rep);
+
+    for (auto& term : terms) {
+        while (powers.size() <= term.exp[variable])
+            powers.push_back(powers.back()*value);
+
+        term.coeff *= powers[term.exp[variable]];
+        term.exp[variable] = 0;
+    }
+
+    return SparsePoly(nVars, terms);
+}
+
+tsym::SparsePoly tsym::SparsePoly::integerPrimitivePart() const
+    /* The lcm of the denominators scales to integer coefficients, the gcd of the resulting
+     * numerators is then divided out. */
+{
+    Int denominators(1);
+    Int numerators(0);
+
+    for (const auto& term : rep)
+        denominators = denominators*term.coeff.denominator()/denominators.gcd(
+                term.coeff.denominator());
+
+    for (const auto& term : rep)
+        numerators = numerators.gcd((term.coeff*Number(denominators)).numerator());
+
+    return rep.empty() ? *this : *this*Number(denominators, numerators);
+}
+
+void tsym::SparsePoly::divide(const SparsePoly& v, size_t first, size_t last,
+        SparsePoly& quotient, SparsePoly& remainder) const
+{
+    SparsePoly partialQuotient;
+    SparsePoly partialRemainder;
+    SparsePoly lCoeffV;
+    SparsePoly tmp;
+    int m;
+    int n;
+
+    quotient = SparsePoly(nVars);
+    remainder = *this;
+
+    if (first == last) {
+        divideByMultiple(v, quotient, remainder);
+        return;
+    } else if (equal(v)) {
+        quotient = SparsePoly(nVars, 1);
+        remainder = SparsePoly(nVars);
+        return;
+    } else if (isZero())
+        return;
+
+    lCoeffV = v.leadingCoeff(first);
+    m = degree(first);
+    n = v.degree(first);
+
+    while (m >= n) {
+        remainder.leadingCoeff(first).divide(lCoeffV, first + 1, last, partialQuotient,
+                partialRemainder);
+
+        if (!partialRemainder.isZero())
+            break;
+
+        tmp = partialQuotient.timesPowerOf(first, static_cast<unsigned>(m - n));
+
+        quotient += tmp;
+        remainder -= tmp*v;
+
+        if (remainder.isZero())
+            break;
+
+        m = remainder.degree(first);
+    }
+}
+
+void tsym::SparsePoly::divideByMultiple(const SparsePoly& v, SparsePoly& quotient,
+        SparsePoly& remainder) const
+    /* Division without any variable succeeds only if the quotient is a rational number. */
+{
+    Number factor;
+
+    if (v.isZero() || rep.size() != v.rep.size())
+        return;
+    else if (isZero()) {
+        remainder = SparsePoly(nVars);
+        return;
+    }
+
+    factor = rep.front().coeff/v.rep.front().coeff;
+
+    for (size_t i = 0; i < rep.size(); ++i)
+        if (rep[i].exp != v.rep[i].exp || rep[i].coeff != factor*v.rep[i].coeff)
+            return;
+
+    quotient = SparsePoly(nVars, factor);
+    remainder = SparsePoly(nVars);
+}
+
+void tsym::SparsePoly::pseudoDivide(const SparsePoly& v, size_t variable, SparsePoly& quotient,
+        SparsePoly& remainder) const
+{
+    pseudoDivide(v, variable, quotient, remainder, true);
+}
+
+tsym::SparsePoly tsym::SparsePoly::pseudoRemainder(const SparsePoly& v, size_t variable) const
+{
+    SparsePoly quotient;
+    SparsePoly remainder;
+
+    pseudoDivide(v, variable, quotient, remainder, false);
+
+    return remainder;
+}
+
+bool tsym::SparsePoly::isDivisibleBy(const SparsePoly& v) const
+    /* Reduction by multiples of v that cancel the leading term of the remainder. This is cheaper
+     * than the recursive division, and it reaches zero exactly if v is a factor, because the
+     * leading term of a product is the product of the leading terms. */
+{
+    SparsePoly remainder(*this);
+    SparsePoly multiple;
+    Exponents exp(nVars);
+    Number factor;
+
+    if (v.isZero())
+        return false;
+
+    while (!remainder.isZero()) {
+        for (size_t i = 0; i < nVars; ++i)
+            if (remainder.rep.front().exp[i] < v.rep.front().exp[i])
+                return false;
+            else
+                exp[i] = remainder.rep.front().exp[i] - v.rep.front().exp[i];
+
+        factor = remainder.rep.front().coeff/v.rep.front().coeff;
+        multiple = v;
+
+        for (auto& term : multiple.rep) {
+            term.coeff *= factor;
+
+            for (size_t i = 0; i < nVars; ++i)
+                term.exp[i] += exp[i];
+        }
+
+        remainder -= multiple;
+    }
+
+    return true;
+}
+
+void tsym::SparsePoly::pseudoDivide(const SparsePoly& v, size_t variable, SparsePoly& quotient,
+        SparsePoly& remainder, bool computeQuotient) const
+{
+    const SparsePoly lCoeffV(v.leadingCoeff(variable));
+    const int n = v.degree(variable);
+    int m = degree(variable);
+    SparsePoly factor;
+    SparsePoly tmp;
+    int sigma = 0;
+
+    assert(!v.isZero());
+
+    quotient = SparsePoly(nVars);
+    remainder = *this;
+
+    while (m >= n) {
+        tmp = remainder.coeff(variable, m).timesPowerOf(variable, static_cast<unsigned>(m - n));
+
+        if (computeQuotient)
+            quotient = lCoeffV*quotient + tmp;
+
+        remainder = lCoeffV*remainder - v*tmp;
+
+        if (remainder.isZero())
+            break;
+
+        ++sigma;
+        m = remainder.degree(variable);
+    }
+
+    factor = lCoeffV.toThe(static_cast<unsigned>(std::max(degree(variable) - n + 1, 0) - sigma));
+
+    remainder *= factor;
+
+    if (computeQuotient)
+        quotient *= factor;
+}
+
+bool tsym::SparsePoly::equal(const SparsePoly& other) const
+{
+    if (nVars != other.nVars || rep.size() != other.rep.size())
+        return false;
+
+    for (size_t i = 0; i < rep.size(); ++i)
+        if (rep[i].exp != other.rep[i].exp || rep[i].coeff != other.rep[i].coeff)
+            return false;
+
+    return true;
+}
+
+bool tsym::SparsePoly::isZero() const
+{
+    return rep.empty();
+}
+
+bool tsym::SparsePoly::isConstant() const
+{
+    return rep.empty() || (rep.size() == 1 && rep.front().exp == Exponents(nVars, 0));
+}
+
+int tsym::SparsePoly::degree(size_t variable) const
+{
+    unsigned result = 0;
+
+    for (const auto& term : rep)
+        result = std::max(result, term.exp[variable]);
+
+    return static_cast<int>(result);
+}
+
+int tsym::SparsePoly::minDegree(size_t variable) const
+{
+    unsigned result = rep.empty() ? 0 : rep.front().exp[variable];
+
+    for (const auto& term : rep)
+        result = std::min(result, term.exp[variable]);
+
+    return static_cast<int>(result);
+}
+
+tsym::SparsePoly tsym::SparsePoly::coeff(size_t variable, int exp) const
+    /* Setting the exponent of one variable to zero in terms that agree in this exponent doesn't
+     * change their order. */
+{
+    SparsePoly result(nVars);
+
+    for (const auto& term : rep)
+        if (static_cast<int>(term.exp[variable]) == exp) {
+            result.rep.push_back(term);
+            result.rep.back().exp[variable] = 0;
+        }
+
+    return result;
+}
+
+tsym::SparsePoly tsym::SparsePoly::leadingCoeff(size_t variable) const
+{
+    return coeff(variable, degree(variable));
+}
+
+tsym::Number tsym::SparsePoly::constant() const
+{
+    if (rep.empty() || rep.back().exp != Exponents(nVars, 0))
+        return 0;
+    else
+        return rep.back().coeff;
+}
+
+size_t tsym::SparsePoly::nVariables() const
+{
+    return nVars;
+}
+
+const std::vector<tsym::SparsePoly::Term>& tsym::SparsePoly::terms() const
+{
+    return rep;
+}
+
+bool tsym::SparsePoly::isGreater(const Term& lhs, const Term& rhs)
+{
+    return lhs.exp > rhs.exp;
+}
+
+bool tsym::operator == (const SparsePoly& lhs, const SparsePoly& rhs)
+{
+    return lhs.equal(rhs);
+}
+
+bool tsym::operator != (const SparsePoly& lhs, const SparsePoly& rhs)
+{
+    return !lhs.equal(rhs);
+}
+
+tsym::SparsePoly tsym::operator + (SparsePoly lhs, const SparsePoly& rhs)
+{
+    lhs += rhs;
+
+    return lhs;
+}
+
+tsym::SparsePoly tsym::operator - (SparsePoly lhs, const SparsePoly& rhs)
+{
+    lhs -= rhs;
+
+    return lhs;
+}
+
+tsym::SparsePoly tsym::operator * (SparsePoly lhs, const SparsePoly& rhs)
+{
+    lhs *= rhs;
+
+    return lhs;
+}
+
+tsym::SparsePoly tsym::operator * (SparsePoly lhs, const Number& rhs)
+{
+    lhs *= rhs;
+
+    return lhs;
+}
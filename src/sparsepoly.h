@@ -0,0 +1,109 @@
+#ifndef TSYM_SPARSEPOLY_H
+#define TSYM_SPARSEPOLY_H
+
+#include <vector>
+#include "baseptr.h"
+#include "baseptrlist.h"
+#include "number.h"
+
+namespace tsym {
+    class SparsePoly {
+        /* Multivariate polynomial with rational coefficients in distributed representation, i.e., a
+         * sorted array of terms, each of them an exponent vector and a coefficient. Variables are
+         * referred to by their position in a list of Symbols that is maintained by the caller.
+         * Terms are sorted lexicographically by their exponents in descending order, such that the
+         * terms of the leading coefficient with respect to the first variable come first.
+         *
+         * In contrast to computations with Base objects, arithmetic operations don't trigger
+         * automatic simplification, which makes this class the working horse of the polynomial
+         * division and gcd algorithms. They convert their arguments once on entry and back on
+         * exit. */
+        public:
+            typedef std::vector<unsigned> Exponents;
+
+            struct Term {
+                Exponents exp;
+                Number coeff;
+            };
+
+            /* Zero polynomial in the given number of variables: */
+            explicit SparsePoly(size_t nVariables = 0);
+            SparsePoly(size_t nVariables, const Number& constant);
+            /* Terms can be given in any order, like terms are collected: */
+            SparsePoly(size_t nVariables, std::vector<Term> terms);
+
+            /* Returns false if the expression isn't a polynomial with rational coefficients in the
+             * given variables, the result is unchanged in that case: */
+            static bool fromBasePtr(const BasePtr& ptr, const BasePtrList& variables,
+                    SparsePoly& result);
+            /* The given list followed by all other Symbols in u and v: */
+            static BasePtrList variables(const BasePtrList& first, const BasePtr& u,
+                    const BasePtr& v);
+            /* The result is an expanded polynomial that is identical to the automatically
+             * simplified expansion of the input of fromBasePtr: */
+            BasePtr toBasePtr(const BasePtrList& variables) const;
+
+            SparsePoly& operator += (const SparsePoly& rhs);
+            SparsePoly& operator -= (const SparsePoly& rhs);
+            SparsePoly& operator *= (const SparsePoly& rhs);
+            SparsePoly& operator *= (const Number& rhs);
+            SparsePoly operator - () const;
+            SparsePoly toThe(unsigned exp) const;
+            SparsePoly timesPowerOf(size_t variable, unsigned exp) const;
+            /* The result doesn't depend on the given variable, but keeps the number of
+             * variables: */
+            SparsePoly evaluate(size_t variable, const Number& value) const;
+            /* Multiple by a positive rational with integer coefficients that have no common
+             * divisor: */
+            SparsePoly integerPrimitivePart() const;
+
+            /* Polynomial division with respect to the variables at the positions first, ..., last -
+             * 1, as described in Cohen [2003], page 211. When the range is empty, the quotient is
+             * non-zero only if this polynomial is a rational multiple of the divisor: */
+            void divide(const SparsePoly& v, size_t first, size_t last, SparsePoly& quotient,
+                    SparsePoly& remainder) const;
+            /* See Cohen [2003], page 240. The divisor must be non-zero: */
+            void pseudoDivide(const SparsePoly& v, size_t variable, SparsePoly& quotient,
+                    SparsePoly& remainder) const;
+            SparsePoly pseudoRemainder(const SparsePoly& v, size_t variable) const;
+            bool isDivisibleBy(const SparsePoly& v) const;
+
+            bool equal(const SparsePoly& other) const;
+            bool isZero() const;
+            bool isConstant() const;
+            /* Returns zero for a zero polynomial, as the degree method of the Base class does: */
+            int degree(size_t variable) const;
+            int minDegree(size_t variable) const;
+            /* The result is constant in the given variable, but keeps the number of variables: */
+            SparsePoly coeff(size_t variable, int exp) const;
+            SparsePoly leadingCoeff(size_t variable) const;
+            /* Coefficient of the constant term: */
+            Number constant() const;
+            size_t nVariables() const;
+            const std::vector<Term>& terms() const;
+
+        private:
+            static bool isGreater(const Term& lhs, const Term& rhs);
+            void sortAndCollect(std::vector<Term>& terms);
+            bool fromBasePtrNonScalar(const BasePtr& ptr, const BasePtrList& variables);
+            bool fromSymbol(const BasePtr& symbol, const BasePtrList& variables);
+            bool fromPower(const BasePtr& power, const BasePtrList& variables);
+            void addOrSubtract(const SparsePoly& rhs, bool subtract);
+            void divideByMultiple(const SparsePoly& v, SparsePoly& quotient,
+                    SparsePoly& remainder) const;
+            void pseudoDivide(const SparsePoly& v, size_t variable, SparsePoly& quotient,
+                    SparsePoly& remainder, bool computeQuotient) const;
+
+            size_t nVars;
+            std::vector<Term> rep;
+    };
+
+    bool operator == (const SparsePoly& lhs, const SparsePoly& rhs);
+    bool operator != (const SparsePoly& lhs, const SparsePoly& rhs);
+    SparsePoly operator + (SparsePoly lhs, const SparsePoly& rhs);
+    SparsePoly operator - (SparsePoly lhs, const SparsePoly& rhs);
+    SparsePoly operator * (SparsePoly lhs, const SparsePoly& rhs);
+    SparsePoly operator * (SparsePoly lhs, const Number& rhs);
+}
+
+#endif
@@ -1,6 +1,8 @@
 
 #include "stringtovar.h"
 #include "parseradapter.h"
+#include "context.h"
+#include "contextdata.h"
 
 tsym::StringToVar::StringToVar(const std::string& source) :
     source(source),
@@ -10,13 +12,21 @@ tsym::StringToVar::StringToVar(const std::string& source) :
 }
 
 void tsym::StringToVar::parse()
+    /* Only successfully parsed strings are cached, such that error messages are reproduced for
+     * every parsing attempt of erroneous input. */
 {
-    result = Var(parserAdapter::parse(source.c_str()));
+    BoundedCache<std::string, BasePtr>& cache(Context::current().data().parseCache);
+    const BasePtr *cached = cache.getCapacity() == 0 ? nullptr : cache.retrieve(source);
 
-    errors = parserAdapter::getErrors();
-    errorIndex = parserAdapter::getFirstErrorIndex();
+    if (cached != nullptr) {
+        result = Var(*cached);
+        return;
+    }
 
-    parserAdapter::clearErrors();
+    result = Var(parserAdapter::parse(source.c_str(), errors, errorIndex));
+
+    if (errors.empty())
+        cache.insert(source, result.getBasePtr());
 }
 
 bool tsym::StringToVar::success() const
@@ -26,7 +26,8 @@ namespace tsym {
          * - "sqrt(2)*sinn(0)" = sqrt(2)*sinn (where 'sinn' is a variable!)
          *
          * This might in many cases be not very accurate, but provides a simple procedure for wrong
-         * input.  */
+         * input. Successfully parsed strings can be cached by the current Context, see
+         * Context::setParseCacheCapacity. */
         public:
             StringToVar(const std::string& source);
 
@@ -1,11 +1,75 @@
 
 #include "subresultantgcd.h"
 #include "product.h"
-#include "power.h"
 #include "numeric.h"
 #include "poly.h"
+#include "sparsepoly.h"
+#include "densepoly.h"
 #include "logging.h"
 
+namespace tsym {
+    namespace {
+        SparsePoly quotient(const SparsePoly& u, const SparsePoly& v, size_t first, size_t last)
+        {
+            SparsePoly result;
+            SparsePoly remainder;
+
+            u.divide(v, first, last, result, remainder);
+
+            return result;
+        }
+
+        SparsePoly power(const SparsePoly& base, int exp)
+            /* A negative exponent only occurs for a constant base, i.e., the initial psi = -1. */
+        {
+            if (exp >= 0)
+                return base.toThe(static_cast<unsigned>(exp));
+
+            return SparsePoly(base.nVariables(), Number(1)/base.constant()).toThe(
+                    static_cast<unsigned>(-exp));
+        }
+
+        SparsePoly univariateSequence(const SparsePoly& u, const SparsePoly& v, int delta)
+            /* The remainder sequence of the gcd method for a single variable, where beta and psi
+             * are numbers and the pseudo-remainders are computed on the dense representation. */
+        {
+            DensePoly denseU;
+            DensePoly denseV;
+            DensePoly remainder;
+            Number beta(Number(-1).toThe(delta));
+            Number psi(-1);
+            Number tmp;
+            int deltaP;
+            int i = 0;
+
+            DensePoly::fromSparse(u, denseU);
+            DensePoly::fromSparse(v, denseV);
+
+            while (true) {
+                remainder = denseU.pseudoRemainder(denseV);
+
+                if (remainder.isZero()) {
+                    denseU = denseV;
+                    break;
+                }
+
+                if (++i > 1) {
+                    deltaP = delta;
+                    delta = denseU.degree() - denseV.degree() + 1;
+                    tmp = -denseU.leadingCoeff();
+                    psi = tmp.toThe(deltaP - 1)/psi.toThe(deltaP - 2);
+                    beta = tmp*psi.toThe(delta - 1);
+                }
+
+                denseU = denseV;
+                denseV = remainder*(Number(1)/beta);
+            }
+
+            return denseU.toSparse(u.nVariables());
+        }
+    }
+}
+
 tsym::BasePtr tsym::SubresultantGcd::gcdAlgo(const BasePtr& u, const BasePtr& v,
         const BasePtrList& L) const
     /* See Cohen [2003], pages 255 - 256. */
@@ -20,53 +84,78 @@ tsym::BasePtr tsym::SubresultantGcd::gcdAlgo(const BasePtr& u, const BasePtr& v,
 
 tsym::BasePtr tsym::SubresultantGcd::gcd(const BasePtr& u, const BasePtr& v,
         const BasePtrList& L) const
+    /* The contents and the gcd of the leading coefficients are computed recursively on Base
+     * objects, the pseudo-remainder sequence itself on the sparse representation. */
 {
     const BasePtr& x(L.front());
     const BasePtrList R(L.rest());
+    const BasePtrList variables(SparsePoly::variables(L, u, v));
+    const size_t nL = L.size();
     const BasePtr uContent(poly::content(u, x, this));
     const BasePtr vContent(poly::content(v, x, this));
     const BasePtr d(compute(uContent, vContent, R));
-    BasePtr U(poly::divide(u, uContent, L).front());
-    BasePtr V(poly::divide(v, vContent, L).front());
+    const BasePtr U(poly::divide(u, uContent, L).front());
+    const BasePtr V(poly::divide(v, vContent, L).front());
     const BasePtr g(compute(U->leadingCoeff(x), V->leadingCoeff(x), R));
+    SparsePoly sparseU;
+    SparsePoly sparseV;
+    SparsePoly sparseG;
+    SparsePoly sparseD;
     int delta = U->degree(x) - V->degree(x) + 1;
-    BasePtr beta(Power::create(Numeric::mOne(), Numeric::create(delta)));
-    BasePtr psi(Numeric::mOne());
-    BasePtr remainder;
-    BasePtr tmp;
+    SparsePoly beta;
+    SparsePoly psi;
+    SparsePoly remainder;
+    SparsePoly tmp;
     int deltaP;
     int i = 0;
 
-    while (true) {
-        remainder = poly::pseudoRemainder(U, V, x);
+    if (!SparsePoly::fromBasePtr(U, variables, sparseU) ||
+            !SparsePoly::fromBasePtr(V, variables, sparseV) ||
+            !SparsePoly::fromBasePtr(g, variables, sparseG) ||
+            !SparsePoly::fromBasePtr(d, variables, sparseD)) {
+        TSYM_WARNING("Non-polynomial input during subres. gcd computation, return 1.");
+        return Numeric::one();
+    }
+
+    beta = power(SparsePoly(variables.size(), -1), delta);
+    psi = SparsePoly(variables.size(), -1);
 
-        if (remainder->isZero()) {
-            U = V;
-            break;
-        } else if (remainder->isUndefined()) {
-            TSYM_WARNING("Undefined remainder during subres. gcd computation, return 1.");
-            return Numeric::one();
-        }
+    if (variables.size() == 1)
+        sparseU = univariateSequence(sparseU, sparseV, delta);
+    else
+        while (true) {
+            remainder = sparseU.pseudoRemainder(sparseV, 0);
 
-        if (++i > 1) {
-            deltaP = delta;
-            delta = U->degree(x) - V->degree(x) + 1;
+            if (remainder.isZero()) {
+                sparseU = sparseV;
+                break;
+            }
 
-            tmp = Product::minus(U->leadingCoeff(x));
+            if (++i > 1) {
+                deltaP = delta;
+                delta = sparseU.degree(0) - sparseV.degree(0) + 1;
 
-            psi = poly::divide(Power::create(tmp, Numeric::create(deltaP - 1))->expand(),
-                    Power::create(psi, Numeric::create(deltaP - 2))->expand(), R).front();
+                tmp = -sparseU.leadingCoeff(0);
 
-            beta = Product::create(tmp, Power::create(psi, Numeric::create(delta - 1)))->expand();
+                psi = quotient(power(tmp, deltaP - 1), power(psi, deltaP - 2), 1, nL);
+
+                beta = tmp*power(psi, delta - 1);
+            }
+
+            sparseU = sparseV;
+            sparseV = quotient(remainder, beta, 0, nL);
         }
 
-        U = V;
-        V = poly::divide(remainder, beta, L).front();
+    tmp = quotient(sparseU.leadingCoeff(0), sparseG, 1, nL);
+    tmp = quotient(sparseU, tmp, 0, nL);
+
+    if (!SparsePoly::fromBasePtr(poly::content(tmp.toBasePtr(variables), x, this), variables,
+                sparseU)) {
+        TSYM_WARNING("Non-polynomial content during subres. gcd computation, return 1.");
+        return Numeric::one();
     }
 
-    tmp = poly::divide(U->leadingCoeff(x), g, R).front();
-    tmp = poly::divide(U, tmp, L).front();
-    tmp = poly::divide(tmp, poly::content(tmp, x, this), L).front();
+    tmp = quotient(tmp, sparseU, 0, nL);
 
-    return Product::create(d, tmp)->expand();
+    return (sparseD*tmp).toBasePtr(variables);
 }
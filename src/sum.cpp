@@ -1,5 +1,6 @@
 
 #include <cassert>
+#include <unordered_map>
 #include "sum.h"
 #include "sumsimpl.h"
 #include "numeric.h"
@@ -7,12 +8,16 @@
 #include "power.h"
 #include "product.h"
 #include "poly.h"
+#include "polyinfo.h"
+#include "symbolmap.h"
+#include "context.h"
+#include "contextdata.h"
+#include "parallel.h"
+#include "zerotest.h"
 
 tsym::Sum::Sum(const BasePtrList& summands) :
     Base(summands)
-{
-    setDebugString();
-}
+{}
 
 tsym::Sum::~Sum() {}
 
@@ -81,45 +86,122 @@ tsym::Number tsym::Sum::numericEval() const
 
 tsym::Fraction tsym::Sum::normal(SymbolMap& map) const
 {
+    const ContextData& settings(Context::current().data());
     std::vector<Fraction> fractions;
 
-    if (expand()->isZero())
+    if (isZeroForNormal(clone()))
         return Fraction(Numeric::zero());
+    else if (settings.normalizationThreads > 1 &&
+            ops.size() >= settings.parallelNormalizationThreshold)
+        return normalInParallel(map, settings.normalizationThreads);
 
     for (const auto& summand : ops)
         fractions.push_back(summand->normal(map));
 
-    return toCommonDenom(fractions);
+    return toCommonDenom(fractions, 1);
 }
 
-tsym::Fraction tsym::Sum::toCommonDenom(const std::vector<Fraction>& operands) const
+tsym::Fraction tsym::Sum::normalInParallel(SymbolMap& map, unsigned nThreads) const
+    /* The given map and its temporary Symbols belong to the context of the calling thread, so every
+     * summand is normalized with a map of its own, and the temporary Symbols are replaced back
+     * before the result leaves the thread. If that result isn't a fraction of polynomials, i.e., it
+     * would require a temporary Symbol of the given map, the summand is normalized once more by the
+     * calling thread. */
 {
-    std::vector<Fraction>::const_iterator it(operands.begin());
-    BasePtr denom(it->denom());
-    BasePtr num(it->num());
-    BasePtr oneOverGcd;
-    BasePtr nextDenom;
-    BasePtr nextNum;
-    BasePtr lcm;
-
-    for (++it; it != operands.end(); ++it) {
-        nextNum = it->num();
-        nextDenom = it->denom();
-
-        if (denom->isEqual(nextDenom)) {
-            num = create(num, nextNum);
-            continue;
-        }
+    const std::vector<BasePtr> summands(ops.begin(), ops.end());
+    std::vector<Fraction> fractions(summands.size());
+
+    runInParallel(summands.size(), nThreads, [&](size_t i, unsigned) {
+            SymbolMap summandMap;
+            const Fraction normalized(summands[i]->normal(summandMap));
+
+            fractions[i] = Fraction(summandMap.replaceTmpSymbolsBackFrom(normalized.num()),
+                    summandMap.replaceTmpSymbolsBackFrom(normalized.denom()));
+            });
+
+    for (size_t i = 0; i < summands.size(); ++i)
+        if (!PolyInfo(fractions[i].num(), fractions[i].denom()).isInputValid())
+            fractions[i] = summands[i]->normal(map);
+
+    return toCommonDenom(fractions, nThreads);
+}
+
+tsym::Fraction tsym::Sum::toCommonDenom(const std::vector<Fraction>& operands,
+        unsigned nThreads) const
+    /* Fractions with equal denominators are combined first, the remaining ones are added pairwise,
+     * level by level, which keeps the intermediate numerators and denominators balanced in size.
+     * The additions of one level are independent of each other and can hence be processed
+     * concurrently. */
+{
+    std::vector<Fraction> fractions(groupByDenom(operands));
+    std::vector<Fraction> sums;
+
+    while (fractions.size() > 1) {
+        sums.resize((fractions.size() + 1)/2);
+
+        runInParallel(fractions.size()/2, nThreads, [&](size_t i, unsigned) {
+                sums[i] = addWithCommonDenom(fractions[2*i], fractions[2*i + 1]);
+                });
+
+        if (fractions.size() % 2 == 1)
+            sums.back() = fractions.back();
+
+        fractions.swap(sums);
+    }
+
+    return fractions.front().cancel();
+}
+
+std::vector<tsym::Fraction> tsym::Sum::groupByDenom(const std::vector<Fraction>& operands)
+    /* Returns one fraction per distinct denominator in the order of first occurrence, its
+     * numerator is the sum of all numerators over this denominator. */
+{
+    std::unordered_map<BasePtr, size_t> indices;
+    std::vector<BasePtrList> numerators;
+    std::vector<Fraction> grouped;
+
+    for (const auto& fraction : operands) {
+        const auto entry = indices.insert(std::make_pair(fraction.denom(), numerators.size()));
+
+        if (entry.second)
+            numerators.push_back(BasePtrList());
+
+        numerators[entry.first->second].push_back(fraction.num());
+    }
+
+    grouped.resize(numerators.size());
+
+    for (const auto& entry : indices)
+        grouped[entry.second] = Fraction(create(numerators[entry.second]), entry.first);
+
+    return grouped;
+}
+
+tsym::Fraction tsym::Sum::addWithCommonDenom(const Fraction& lhs, const Fraction& rhs)
+    /* The resulting fraction isn't canceled, its denominator is the lcm of the given ones. The
+     * cofactors of the gcd are computed by polynomial division, as an expansion of a denominator
+     * times the inverse gcd doesn't necessarily cancel the latter. */
+{
+    BasePtr lhsCofactor;
+    BasePtr rhsCofactor;
+    BasePtr gcd;
+
+    if (lhs.denom()->isEqual(rhs.denom()))
+        return Fraction(create(lhs.num(), rhs.num()), lhs.denom());
 
-        oneOverGcd = Power::oneOver(poly::gcd(denom, nextDenom));
-        lcm = Product::create(nextDenom, oneOverGcd)->expand();
+    gcd = poly::gcd(lhs.denom(), rhs.denom());
 
-        num = create(Product::create(num, lcm)->expand(),
-                Product::create(nextNum, denom, oneOverGcd)->expand());
-        denom = Product::create(denom, lcm)->expand();
+    if (gcd->isOne()) {
+        lhsCofactor = lhs.denom();
+        rhsCofactor = rhs.denom();
+    } else {
+        lhsCofactor = poly::divide(lhs.denom(), gcd).front();
+        rhsCofactor = poly::divide(rhs.denom(), gcd).front();
     }
 
-    return Fraction(num, denom).cancel();
+    return Fraction(create(Product::create(lhs.num(), rhsCofactor)->expand(),
+                Product::create(rhs.num(), lhsCofactor)->expand()),
+            Product::create(lhs.denom(), rhsCofactor)->expand());
 }
 
 tsym::BasePtr tsym::Sum::diffWrtSymbol(const BasePtr& symbol) const
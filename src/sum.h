@@ -8,6 +8,10 @@
 namespace tsym {
     class Sum : public Base {
         public:
+            friend class DagReader;
+            /* Creates sums of collected summands, which only need to be sorted: */
+            friend class TermCollector;
+
             static BasePtr create(const BasePtr& s1, const BasePtr& s2);
             static BasePtr create(const BasePtr& s1, const BasePtr& s2, const BasePtr& s3);
             static BasePtr create(const BasePtr& s1, const BasePtr& s2, const BasePtr& s3,
@@ -40,7 +44,10 @@ namespace tsym {
             ~Sum();
 
             static BasePtr createSimplifiedSum(const BasePtrList& summands);
-            Fraction toCommonDenom(const std::vector<Fraction>& operands) const;
+            Fraction normalInParallel(SymbolMap& map, unsigned nThreads) const;
+            Fraction toCommonDenom(const std::vector<Fraction>& operands, unsigned nThreads) const;
+            static std::vector<Fraction> groupByDenom(const std::vector<Fraction>& operands);
+            static Fraction addWithCommonDenom(const Fraction& lhs, const Fraction& rhs);
             int sign() const;
             int signOfNumericParts() const;
             int signOfSymbolicParts() const;
@@ -40,41 +40,71 @@ tsym::BasePtrList tsym::SumSimpl::simplTwoSummandsWithSum(const BasePtr& s1, con
 }
 
 tsym::BasePtrList tsym::SumSimpl::merge(const BasePtrList& l1, const BasePtrList& l2)
+    /* Iterative form of the recursive merge, where the first elements of both lists are simplified,
+     * the result is taken over, and the remaining elements are merged. */
 {
-    if (l1.empty())
-        return l2;
-    else if (l2.empty())
-        return l1;
-    else
-        return mergeNonEmpty(l1, l2);
-}
-
-tsym::BasePtrList tsym::SumSimpl::mergeNonEmpty(const BasePtrList& p, const BasePtrList& q)
-{
-    const BasePtr p1(p.front());
-    const BasePtr q1(q.front());
-    const BasePtrList p1q1(p1, q1);
-    const BasePtrList q1p1(q1, p1);
-    BasePtrList pRest(p.rest());
-    BasePtrList qRest(q.rest());
+    BasePtrList::const_iterator p(l1.begin());
+    BasePtrList::const_iterator q(l2.begin());
+    BasePtrList result;
     BasePtrList res;
 
-    res = simplTwoSummands(p1, q1);
-
-    if (res.empty())
-        return merge(pRest, qRest);
-    else if (res.size() == 1 && res.front()->isZero())
-        return BasePtrList(merge(pRest, qRest));
-    else if (res.size() == 1)
-        return BasePtrList(res, merge(pRest, qRest));
-    else if (res.isEqual(p1q1))
-        return BasePtrList(p1, merge(pRest, q));
-    else if (res.isEqual(q1p1))
-        return BasePtrList(q1, merge(p, qRest));
-
-    TSYM_ERROR("Error merging non-empty lists: ", p, ", ", q);
+    while (p != l1.end() && q != l2.end()) {
+        res = simplTwoSummands(*p, *q);
+
+        if (res.empty() || (res.size() == 1 && res.front()->isZero())) {
+            ++p;
+            ++q;
+        } else if (res.size() == 1) {
+            result.push_back(res.front());
+            ++p;
+            ++q;
+        } else if (res.isEqual(BasePtrList(*p, *q)))
+            result.push_back(*p++);
+        else if (res.isEqual(BasePtrList(*q, *p)))
+            result.push_back(*q++);
+        else {
+            TSYM_ERROR("Error merging non-empty lists: ", l1, ", ", l2);
+            return result;
+        }
+    }
+
+    result.insert(result.end(), p, l1.end());
+    result.insert(result.end(), q, l2.end());
+
+    return result;
+}
+
+void tsym::SumSimpl::mergeIntoSimplified(const BasePtr& summand, BasePtrList& simplified)
+    /* Has the same effect as merging a list with the given summand as the only element into the
+     * simplified list, but modifies the latter in place. For summands that are already in order,
+     * this doesn't require to copy the list. */
+{
+    BasePtrList::iterator it(simplified.begin());
+    BasePtrList res;
 
-    return BasePtrList();
+    while (it != simplified.end()) {
+        res = simplTwoSummands(summand, *it);
+
+        if (res.empty() || (res.size() == 1 && res.front()->isZero())) {
+            simplified.erase(it);
+            return;
+        } else if (res.size() == 1) {
+            *it = res.front();
+            return;
+        } else if (res.isEqual(BasePtrList(summand, *it))) {
+            simplified.insert(it, summand);
+            return;
+        } else if (res.isEqual(BasePtrList(*it, summand)))
+            ++it;
+        else {
+            TSYM_ERROR("Error merging ", summand, " into ", simplified);
+            while (it != simplified.end())
+                it = simplified.erase(it);
+            return;
+        }
+    }
+
+    simplified.push_back(summand);
 }
 
 tsym::BasePtrList tsym::SumSimpl::simplTwoSummandsWithoutSum(const BasePtr& s1, const BasePtr& s2)
@@ -163,10 +193,10 @@ bool tsym::SumSimpl::haveContractableSinCos(const BasePtr& s1, const BasePtr& s2
 {
     const BasePtr nonConst1(s1->nonConstTerm());
     const BasePtr nonConst2(s2->nonConstTerm());
-    const BasePtr const1(s1->constTerm());
-    const BasePtr const2(s2->constTerm());
 
-    if (const1->isEqual(const2) && areSinAndCosSquare(nonConst1, nonConst2))
+    /* The constant terms are only compared for squares of sine and cosine, as their creation
+     * isn't for free: */
+    if (areSinAndCosSquare(nonConst1, nonConst2) && s1->constTerm()->isEqual(s2->constTerm()))
         return haveEqualFirstOperands(nonConst1, nonConst2);
     else
         return false;
@@ -204,15 +234,19 @@ bool tsym::SumSimpl::haveEqualFirstOperands(const BasePtr& pow1, const BasePtr&
 }
 
 tsym::BasePtrList tsym::SumSimpl::simplNSummands(const BasePtrList& u)
+    /* The first summand is merged with the simplified rest, which is done from the back of the
+     * list in a loop instead of recursively. */
 {
-    const BasePtrList uRest(u.rest());
-    const BasePtr u1(u.front());
-    BasePtrList simplRest;
+    BasePtrList::const_reverse_iterator it(u.rbegin());
+    const BasePtr& last(*it++);
+    const BasePtr& secondLast(*it++);
+    BasePtrList simplified(simplTwoSummands(secondLast, last));
 
-    simplRest = simplify(uRest);
+    for (; it != u.rend(); ++it)
+        if ((*it)->isSum())
+            simplified = merge((*it)->operands(), simplified);
+        else
+            mergeIntoSimplified(*it, simplified);
 
-    if (u1->isSum())
-        return merge(u1->operands(), simplRest);
-    else
-        return merge(BasePtrList(u1), simplRest);
+    return simplified;
 }
@@ -13,7 +13,7 @@ namespace tsym {
             BasePtrList simplTwoSummands(const BasePtr& s1, const BasePtr& s2);
             BasePtrList simplTwoSummandsWithSum(const BasePtr& s1, const BasePtr& s2);
             BasePtrList merge(const BasePtrList& l1, const BasePtrList& l2);
-            BasePtrList mergeNonEmpty(const BasePtrList& p, const BasePtrList& q);
+            void mergeIntoSimplified(const BasePtr& summand, BasePtrList& simplified);
             BasePtrList simplTwoSummandsWithoutSum(const BasePtr& s1, const BasePtr& s2);
             BasePtrList simplTwoNumerics(const BasePtr& s1, const BasePtr& s2);
             bool haveEqualNonConstTerms(const BasePtr& s1, const BasePtr& s2);
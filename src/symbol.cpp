@@ -2,29 +2,21 @@
 #include <sstream>
 #include "symbol.h"
 #include "cache.h"
+#include "context.h"
+#include "contextdata.h"
 #include "numeric.h"
 
-unsigned tsym::Symbol::tmpCounter = 0;
+std::atomic<unsigned> tsym::Symbol::tmpCounter(0);
 
 tsym::Symbol::Symbol(const Name& name, bool positive) :
     symbolName(name),
     positive(positive)
-{
-    setDebugString();
-}
+{}
 
 tsym::Symbol::Symbol(unsigned tmpId, bool positive) :
     symbolName(tmpId),
     positive(positive)
-{
-    setDebugString();
-}
-
-tsym::Symbol::~Symbol()
-{
-    if (symbolName.isNumericId())
-        --tmpCounter;
-}
+{}
 
 tsym::BasePtr tsym::Symbol::create(const std::string& name)
 {
@@ -45,7 +37,7 @@ tsym::BasePtr tsym::Symbol::create(const Name& name, bool positive)
 
 tsym::BasePtr tsym::Symbol::createNonEmptyName(const Name& name, bool positive)
 {
-    static Cache<BasePtr, BasePtr> pool;
+    Cache<BasePtr, BasePtr>& pool(Context::current().data().symbolPool);
     const BasePtr symbol(new Symbol(name, positive));
     const BasePtr *cached = pool.retrieve(symbol);
 
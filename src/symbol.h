@@ -1,6 +1,7 @@
 #ifndef TSYM_SYMBOL_H
 #define TSYM_SYMBOL_H
 
+#include <atomic>
 #include <string>
 #include "base.h"
 
@@ -35,15 +36,16 @@ namespace tsym {
             Symbol(unsigned tmpId, bool positive);
             Symbol(const Symbol& other) = delete;
             Symbol& operator = (const Symbol& other) = delete;
-            ~Symbol();
 
             static BasePtr create(const Name& name, bool positive);
             static BasePtr createNonEmptyName(const Name& name, bool positive);
             bool isEqualOtherSymbol(const BasePtr& other) const;
 
+            /* Shared by all contexts and threads, such that temporary Symbols are unique within the
+             * process, too: */
+            static std::atomic<unsigned> tmpCounter;
             const Name symbolName;
             const bool positive;
-            static unsigned tmpCounter;
     };
 }
 
@@ -0,0 +1,100 @@
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include "termcollector.h"
+#include "numeric.h"
+#include "product.h"
+#include "sum.h"
+#include "undefined.h"
+#include "order.h"
+
+namespace tsym {
+    namespace {
+        BasePtrList toList(const std::vector<BasePtr>& items)
+        {
+            BasePtrList list;
+
+            for (const auto& item : items)
+                list.push_back(item);
+
+            return list;
+        }
+    }
+}
+
+void tsym::TermCollector::add(const BasePtr& term)
+{
+    if (term->isSum())
+        for (const auto& summand : term->operands())
+            add(summand);
+    else
+        coeffs[term->nonNumericTerm()] += term->numericTerm()->numericEval();
+}
+
+void tsym::TermCollector::merge(const TermCollector& other)
+{
+    for (const auto& entry : other.coeffs)
+        coeffs[entry.first] += entry.second;
+}
+
+tsym::BasePtr tsym::TermCollector::sum() const
+    /* The automatic simplification can only combine distinct summands, if they have a constant
+     * prefactor (sqrt(2)*a + 2*sqrt(2)*a) or are squares of functions (sin(a)^2 + cos(a)^2). Only
+     * these are simplified as a sum, while the others are merely sorted into canonical order. The
+     * results are merged, unless the simplification yields summands that aren't of that kind. */
+{
+    std::vector<BasePtr> plain;
+    std::vector<BasePtr> special;
+    std::vector<BasePtr> merged;
+    BasePtr simplified;
+
+    for (const auto& entry : coeffs)
+        if (entry.first->isUndefined())
+            return Undefined::create();
+        else if (entry.second.isZero())
+            continue;
+        else if (isPlain(entry.first))
+            plain.push_back(Product::create(Numeric::create(entry.second), entry.first));
+        else
+            special.push_back(Product::create(Numeric::create(entry.second), entry.first));
+
+    std::sort(plain.begin(), plain.end(), isInOrder);
+    std::sort(special.begin(), special.end(), isInOrder);
+
+    if (special.size() > 1) {
+        simplified = Sum::create(toList(special));
+
+        if (simplified->isSum())
+            special.assign(simplified->operands().begin(), simplified->operands().end());
+        else
+            special.assign(simplified->isZero() ? 0 : 1, simplified);
+
+        for (const auto& summand : special)
+            if (isPlain(summand->nonNumericTerm()))
+                return Sum::create(BasePtrList(toList(plain), toList(special)));
+    }
+
+    std::merge(plain.begin(), plain.end(), special.begin(), special.end(),
+            std::back_inserter(merged), isInOrder);
+
+    if (merged.empty())
+        return Numeric::zero();
+    else if (merged.size() == 1)
+        return merged.front();
+    else
+        return BasePtr(new Sum(toList(merged)));
+}
+
+bool tsym::TermCollector::isPlain(const BasePtr& nonNumericTerm)
+{
+    if (nonNumericTerm->isPower() && nonNumericTerm->base()->isFunction())
+        return false;
+    else
+        return nonNumericTerm->constTerm()->isOne();
+}
+
+bool tsym::TermCollector::isInOrder(const BasePtr& lhs, const BasePtr& rhs)
+{
+    return order::doPermute(rhs, lhs);
+}
@@ -0,0 +1,28 @@
+#ifndef TSYM_TERMCOLLECTOR_H
+#define TSYM_TERMCOLLECTOR_H
+
+#include <unordered_map>
+#include "baseptr.h"
+#include "number.h"
+
+namespace tsym {
+    class TermCollector {
+        /* Accumulates the summands of an expansion by their non-numeric part, i.e., the numeric
+         * coefficients of equal monomials are added up in a hash map instead of merging partial
+         * sums. The automatic simplification of the resulting sum thus takes place only once. */
+        public:
+            /* Sums are added summand by summand: */
+            void add(const BasePtr& term);
+            /* Adds the coefficients collected by another instance, e.g. of a worker thread: */
+            void merge(const TermCollector& other);
+            BasePtr sum() const;
+
+        private:
+            static bool isPlain(const BasePtr& nonNumericTerm);
+            static bool isInOrder(const BasePtr& lhs, const BasePtr& rhs);
+
+            std::unordered_map<BasePtr, Number> coeffs;
+    };
+}
+
+#endif
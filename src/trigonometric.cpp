@@ -39,9 +39,7 @@ tsym::Trigonometric::Trigonometric(const BasePtrList& args, Type type) :
     /* Points to ops.front() except for atan2: */
     arg2(ops.back()),
     type(type)
-{
-    setDebugString();
-}
+{}
 
 tsym::Trigonometric::~Trigonometric() {}
 
@@ -466,7 +464,7 @@ tsym::BasePtr tsym::Trigonometric::diffWrtSymbol(const BasePtr& symbol) const
 
 tsym::BasePtr tsym::Trigonometric::diffWrtSymbol(const BasePtr& arg, const BasePtr& symbol) const
 {
-    const BasePtr outerDerivative(arg->diffWrtSymbol(symbol));
+    const BasePtr outerDerivative(arg->diff(symbol));
     const BasePtr innerDerivative(innerDiff());
 
     return Product::create(innerDerivative, outerDerivative)->normal();
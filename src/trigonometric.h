@@ -13,6 +13,8 @@ namespace tsym {
          * counterparts are resolved for numerically evaluable arguments, e.g. asin(sin(1/2)) = 1/2
          * or acos(cos(11/3*pi - sqrt(2))) = pi/3 + sqrt(2). */
         public:
+            friend class DagReader;
+
             static BasePtr createSin(const BasePtr& arg);
             static BasePtr createCos(const BasePtr& arg);
             static BasePtr createTan(const BasePtr& arg);
@@ -5,9 +5,7 @@
 #include "logging.h"
 
 tsym::Undefined::Undefined()
-{
-    setDebugString();
-}
+{}
 
 tsym::Undefined::~Undefined() {}
 
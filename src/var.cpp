@@ -9,11 +9,14 @@
 #include "sum.h"
 #include "product.h"
 #include "power.h"
-#include "printer.h"
+#include "bufferprinter.h"
 #include "fraction.h"
 #include "symbolmap.h"
 #include "logging.h"
 #include "globals.h"
+#include "zerotest.h"
+#include "context.h"
+#include "contextdata.h"
 
 namespace tsym {
     namespace {
@@ -181,17 +184,22 @@ tsym::Var tsym::Var::expand() const
 
 tsym::Var tsym::Var::normal() const
 {
-    auto ts = std::chrono::high_resolution_clock::now();
-    const BasePtr normalized((*rep)->normal());
+    const bool logTiming = TSYM_LOG_ENABLED(TSYM_LOG_LEVEL_DEBUG);
+    std::chrono::high_resolution_clock::time_point ts;
     std::chrono::microseconds ms;
-    decltype(ts) te;
+    BasePtr normalized;
 
-    te = std::chrono::high_resolution_clock::now();
-    ms = std::chrono::duration_cast<std::chrono::microseconds>(te - ts);
+    if (logTiming)
+        ts = std::chrono::high_resolution_clock::now();
 
-    if (!normalized->isEqual(*rep))
+    normalized = (*rep)->normal();
+
+    if (logTiming && !normalized->isEqual(*rep)) {
+        ms = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - ts);
         TSYM_DEBUG("Normalized ", *rep, " to ", normalized, " in %.2f ms.",
                 static_cast<float>(ms.count())/1000.0);
+    }
 
     return Var(normalized);
 }
@@ -216,6 +224,21 @@ bool tsym::Var::isZero() const
     return (*rep)->isZero();
 }
 
+bool tsym::Var::isZeroProbabilistic() const
+{
+    ContextData& data(Context::current().data());
+    ZeroTest test(data.zeroTestErrorBound, data.zeroTestGenerator);
+
+    switch (test.test(*rep)) {
+        case ZeroTest::Result::ZERO:
+            return true;
+        case ZeroTest::Result::NONZERO:
+            return false;
+        default:
+            return normal().isZero();
+    }
+}
+
 bool tsym::Var::isPositive() const
 {
     return (*rep)->isPositive();
@@ -396,11 +419,13 @@ tsym::Var tsym::operator / (Var lhs, const Var& rhs)
 
 std::ostream& tsym::operator << (std::ostream& stream, const Var& var)
 {
-    Printer printer(var);
+    std::string str;
+    BufferPrinter printer(str);
 
-    printer.print(stream);
+    printer.print(var);
 
-    return stream;
+    /* Inserted as a whole, such that the width and fill settings of the stream apply: */
+    return stream << str;
 }
 
 std::ostream& tsym::operator << (std::ostream& stream, const Var::Type& type)
@@ -54,6 +54,12 @@ namespace tsym {
             bool equal(const Var& other) const;
             bool has(const Var& other) const;
             bool isZero() const;
+            /* Checks whether the normalized expression is zero by evaluating it at random points
+             * modulo large primes, which is usually much faster than normal().isZero(). A zero
+             * result is wrong with a probability below the error bound of the current Context. If
+             * the expression contains Functions, Constants, floating point numbers or non-integer
+             * powers, it is normalized instead: */
+            bool isZeroProbabilistic() const;
             bool isPositive() const;
             bool isNegative() const;
             Type type() const;
@@ -0,0 +1,229 @@
+
+#include <algorithm>
+#include <cmath>
+#include "zerotest.h"
+#include "base.h"
+#include "number.h"
+#include "context.h"
+#include "contextdata.h"
+
+namespace tsym {
+    namespace {
+        /* Lower bound of the number of primes between 2^30 and 2^31: */
+        const double nPrimes = 5.0e7;
+        const int maxPoints = 64;
+
+        double bits(const Int& n)
+        {
+            if (n.fitsIntoLong())
+                return std::log2(std::fabs(n.toDouble()) + 1.0);
+            else
+                return 64.0*static_cast<double>(n.nWords());
+        }
+    }
+}
+
+tsym::ZeroTest::ZeroTest(double errorBound, std::mt19937_64& generator) :
+    errorBound(errorBound),
+    generator(generator),
+    p(2),
+    isUnlucky(false)
+{}
+
+tsym::ZeroTest::Result tsym::ZeroTest::test(const BasePtr& expr)
+{
+    double probability = 1.0;
+    double perPoint;
+    Image image;
+
+    for (int i = 0; i < maxPoints; ++i) {
+        p = randomPrime();
+        isUnlucky = false;
+        symbolValues.clear();
+        images.clear();
+
+        if (!evaluate(expr, image))
+            return Result::INCONCLUSIVE;
+        else if (isUnlucky)
+            continue;
+        else if (image.value != 0)
+            return Result::NONZERO;
+
+        /* Every prime dividing the coefficients is larger than 2^30: */
+        perPoint = image.numDegree/static_cast<double>(p) + image.numBits/30.0/nPrimes;
+
+        if (perPoint > 0.5)
+            return Result::INCONCLUSIVE;
+
+        probability *= perPoint;
+
+        if (probability <= errorBound)
+            return Result::ZERO;
+    }
+
+    return Result::INCONCLUSIVE;
+}
+
+tsym::ZeroTest::Residue tsym::ZeroTest::randomPrime()
+{
+    std::uniform_int_distribution<Residue> candidates(Residue(1) << 30, (Residue(1) << 31) - 1);
+    Residue candidate;
+
+    do
+        candidate = candidates(generator) | 1u;
+    while (!modular::isPrime(candidate));
+
+    return candidate;
+}
+
+bool tsym::ZeroTest::evaluate(const BasePtr& expr, Image& image)
+{
+    const auto cached = images.find(&*expr);
+    bool success = true;
+
+    if (cached != images.end()) {
+        image = cached->second;
+        return true;
+    }
+
+    if (expr->isNumeric())
+        success = evaluateNumeric(expr, image);
+    else if (expr->isSymbol()) {
+        const auto value = symbolValues.insert(std::make_pair(expr, Residue(0)));
+
+        if (value.second)
+            value.first->second = std::uniform_int_distribution<Residue>(0, p - 1)(generator);
+
+        image = { value.first->second, 1.0, 0.0, 0.0, 0.0 };
+    } else if (expr->isSum())
+        success = evaluateSum(expr, image);
+    else if (expr->isProduct())
+        success = evaluateProduct(expr, image);
+    else if (expr->isPower())
+        success = evaluatePower(expr, image);
+    else
+        return false;
+
+    if (success)
+        images[&*expr] = image;
+
+    return success;
+}
+
+bool tsym::ZeroTest::evaluateNumeric(const BasePtr& numeric, Image& image)
+{
+    const Number n(numeric->numericEval());
+    Residue num;
+    Residue denom;
+
+    if (!n.isRational())
+        return false;
+
+    num = modular::reduce(n.numerator(), p);
+    denom = modular::reduce(n.denominator(), p);
+    image = { 0, 0.0, 0.0, bits(n.numerator()), bits(n.denominator()) };
+
+    if (denom == 0 || (num == 0 && !n.isZero()))
+        isUnlucky = true;
+    else
+        image.value = num*modular::inverse(denom, p) % p;
+
+    return true;
+}
+
+bool tsym::ZeroTest::evaluateSum(const BasePtr& sum, Image& image)
+    /* The denominator of a sum of fractions divides the product of their denominators. */
+{
+    double maxDegreeDiff = 0.0;
+    double maxBitsDiff = 0.0;
+    Image summand;
+
+    image = { 0, 0.0, 0.0, 0.0, 0.0 };
+
+    for (const auto& operand : sum->operands()) {
+        if (!evaluate(operand, summand))
+            return false;
+
+        image.value = (image.value + summand.value) % p;
+        image.denomDegree += summand.denomDegree;
+        image.denomBits += summand.denomBits;
+        maxDegreeDiff = std::max(maxDegreeDiff, summand.numDegree - summand.denomDegree);
+        maxBitsDiff = std::max(maxBitsDiff, summand.numBits - summand.denomBits);
+    }
+
+    image.numDegree = image.denomDegree + maxDegreeDiff;
+    image.numBits = image.denomBits + maxBitsDiff +
+        std::log2(static_cast<double>(sum->operands().size()));
+
+    return true;
+}
+
+bool tsym::ZeroTest::evaluateProduct(const BasePtr& product, Image& image)
+{
+    Image factor;
+
+    image = { 1, 0.0, 0.0, 0.0, 0.0 };
+
+    for (const auto& operand : product->operands()) {
+        if (!evaluate(operand, factor))
+            return false;
+
+        image.value = image.value*factor.value % p;
+        image.numDegree += factor.numDegree;
+        image.denomDegree += factor.denomDegree;
+        image.numBits += factor.numBits;
+        image.denomBits += factor.denomBits;
+    }
+
+    return true;
+}
+
+bool tsym::ZeroTest::evaluatePower(const BasePtr& power, Image& image)
+{
+    const BasePtr exp(power->exp());
+    Number n;
+    Image base;
+    double k;
+
+    if (!exp->isNumeric())
+        return false;
+
+    n = exp->numericEval();
+
+    if (!n.isInt() || !evaluate(power->base(), base))
+        return false;
+
+    k = n.abs().toDouble();
+
+    if (n.sign() == 1)
+        image = { 0, k*base.numDegree, k*base.denomDegree, k*base.numBits, k*base.denomBits };
+    else
+        image = { 0, k*base.denomDegree, k*base.numDegree, k*base.denomBits, k*base.numBits };
+
+    if (base.value == 0)
+        isUnlucky = isUnlucky || n.sign() == -1;
+    else {
+        /* Fermat's little theorem allows for reducing the exponent modulo p - 1: */
+        image.value = modular::power(base.value, modular::reduce(n.numerator().abs(), p - 1), p);
+
+        if (n.sign() == -1)
+            image.value = modular::inverse(image.value, p);
+    }
+
+    return true;
+}
+
+bool tsym::isZeroForNormal(const BasePtr& expr)
+{
+    ContextData& data(Context::current().data());
+    ZeroTest test(data.zeroTestErrorBound, data.zeroTestGenerator);
+
+    switch (test.test(expr)) {
+        case ZeroTest::Result::ZERO:
+            return true;
+        case ZeroTest::Result::NONZERO:
+            return false;
+        default:
+            return expr->expand()->isZero();
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef TSYM_ZEROTEST_H
+#define TSYM_ZEROTEST_H
+
+#include <random>
+#include <unordered_map>
+#include "baseptr.h"
+#include "modular.h"
+
+namespace tsym {
+    class ZeroTest {
+        /* Probabilistic test whether an expression is zero as a rational function of its Symbols.
+         * The expression is evaluated at random points modulo large primes, which is cheap
+         * compared to an expansion or normalization. A non-zero image proves that the expression
+         * isn't zero. Every point uses a prime drawn at random from those between 2^30 and 2^31.
+         * A non-zero numerator can vanish at such a point for two reasons: the prime divides all
+         * of its integer coefficients, or the point is a root of its image modulo the prime. The
+         * first probability is bounded by the number of these primes dividing the coefficients,
+         * which follows from a bound of their size. The second one is at most d/p
+         * (Schwartz-Zippel), where d is an upper bound of the degree of the numerator. Points are
+         * evaluated until the product of these probabilities is below the error bound. Primes
+         * dividing a number of the expression are skipped right away. Functions, Constants,
+         * floating point numbers and non-integer exponents can't be evaluated that way. For
+         * expressions with such components, or if the bounds are too large, the test is
+         * inconclusive. */
+        public:
+            enum class Result { ZERO, NONZERO, INCONCLUSIVE };
+
+            /* The generator is only referenced, it must outlive this instance: */
+            ZeroTest(double errorBound, std::mt19937_64& generator);
+
+            Result test(const BasePtr& expr);
+
+        private:
+            typedef modular::Residue Residue;
+
+            struct Image {
+                Residue value;
+                /* Upper bounds of the degrees of numerator and denominator: */
+                double numDegree;
+                double denomDegree;
+                /* Upper bounds of the binary logarithm of the sum of the absolute values of the
+                 * integer coefficients of numerator and denominator: */
+                double numBits;
+                double denomBits;
+            };
+
+            Residue randomPrime();
+
+            bool evaluate(const BasePtr& expr, Image& image);
+            bool evaluateNumeric(const BasePtr& numeric, Image& image);
+            bool evaluateSum(const BasePtr& sum, Image& image);
+            bool evaluateProduct(const BasePtr& product, Image& image);
+            bool evaluatePower(const BasePtr& power, Image& image);
+
+            const double errorBound;
+            std::mt19937_64& generator;
+            /* Prime and random values of the Symbols for the current point: */
+            Residue p;
+            std::unordered_map<BasePtr, Residue> symbolValues;
+            /* Images of already evaluated subexpressions of the current point: */
+            std::unordered_map<const Base*, Image> images;
+            /* Set when a denominator vanishes at the current point or the prime divides a number of
+             * the expression: */
+            bool isUnlucky;
+    };
+
+    /* Zero test with the error bound of the current Context, for the shortcut at the beginning of
+     * a normalization. Inconclusive tests are decided by the expansion of the expression: */
+    bool isZeroForNormal(const BasePtr& expr);
+}
+
+#endif
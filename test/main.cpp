@@ -9,6 +9,7 @@
 #include "poly.h"
 #include "name.h"
 #include "abc.h"
+#include "context.h"
 #include "plic/plic.h"
 #include "CppUTest/CommandLineTestRunner.h"
 
@@ -22,6 +23,8 @@ void initConstructOnFirstUse()
     tsym::BasePtr undefined;
     tsym::Number n(1);
 
+    tsym::Context::current();
+
     n /= n;
     n -= n;
 
@@ -0,0 +1,125 @@
+
+#include <sstream>
+#include "bufferprinter.h"
+#include "printer.h"
+#include "number.h"
+#include "context.h"
+#include "globals.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(BufferPrinter)
+{
+    Var a;
+    Var b;
+    Var c;
+
+    void setup()
+    {
+        a = Var("a");
+        b = Var("b");
+        c = Var("c");
+    }
+
+    std::string viaStream(const Var& expr)
+    {
+        std::stringstream stream;
+
+        stream << expr;
+
+        return stream.str();
+    }
+
+    std::string viaPrinter(const Var& expr)
+    {
+        const Printer printer(expr.getBasePtr());
+
+        return printer.getStr();
+    }
+};
+
+TEST(BufferPrinter, identicalToPrinter)
+{
+    const Var expr(a*b/(c*sqrt(Var(2))) - pow(a + b, Var(-2, 3)) + sin(a)*atan2(b, c) - 2*Pi*Euler);
+    std::string str;
+
+    BufferPrinter(str).print(expr);
+
+    CHECK_EQUAL(viaPrinter(expr), str);
+    CHECK_EQUAL(viaStream(expr), str);
+}
+
+TEST(BufferPrinter, appendToSameString)
+{
+    std::string str("x = ");
+    BufferPrinter printer(str);
+
+    printer.print(a + b);
+    str.append(", ");
+    printer.print(Var(1, 3));
+
+    CHECK_EQUAL("x = a + b, 1/3", str);
+}
+
+TEST(BufferPrinter, numbers)
+{
+    std::string str;
+    BufferPrinter printer(str);
+
+    printer.print(Number(-17, 4));
+    str.push_back(' ');
+    printer.print(Number(0.123456));
+    str.push_back(' ');
+    printer.print(Number(Int("123456789012345678901234567890")));
+
+    CHECK_EQUAL("-17/4 0.123456 123456789012345678901234567890", str);
+}
+
+TEST(BufferPrinter, chunkedSink)
+{
+    const Var expr((a + b + c).toThe(5).expand());
+    std::vector<size_t> chunkLengths;
+    std::string str;
+    BufferPrinter printer([&str, &chunkLengths](const char *data, size_t length) {
+            str.append(data, length);
+            chunkLengths.push_back(length);
+            }, 16);
+
+    printer.print(expr);
+
+    CHECK_EQUAL(viaPrinter(expr), str);
+    CHECK(chunkLengths.size() > 1);
+
+    for (size_t i = 0; i + 1 < chunkLengths.size(); ++i)
+        CHECK(chunkLengths[i] >= 16);
+}
+
+TEST(BufferPrinter, settingsOfContext)
+{
+    const Var expr(a*c/b);
+    std::string str;
+
+    Context::current().disableFractions();
+    BufferPrinter(str).print(expr);
+    Context::current().enableFractions();
+
+    CHECK_EQUAL("a*c/b", viaPrinter(expr));
+    CHECK_EQUAL("a*b^(-1)*c", str);
+}
+
+TEST(BufferPrinter, deeplyNestedExpression)
+{
+    const size_t depth = 2000;
+    Var expr(a);
+    std::string str;
+
+    for (size_t i = 0; i < depth; ++i)
+        expr = sin(expr);
+
+    BufferPrinter(str).print(expr);
+
+    CHECK_EQUAL(depth*5 + 1, str.size());
+    CHECK_EQUAL("sin(sin(", str.substr(0, 8));
+    CHECK_EQUAL("(a)))", str.substr(depth*4 - 1, 5));
+}
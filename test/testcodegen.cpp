@@ -0,0 +1,190 @@
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+#include "codegen.h"
+#include "globals.h"
+#include "baseptr.h"
+#include "base.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(CodeGen)
+{
+    std::string directory;
+    std::string sourceFile;
+    std::string executable;
+    std::string outputFile;
+    const std::vector<double> values { 0.3, 1.7, 2.2 };
+    Var a;
+    Var b;
+    Var c;
+    std::vector<Var> symbols;
+
+    void setup()
+    {
+        a = Var("a");
+        b = Var("b");
+        c = Var("c");
+
+        symbols = { a, b, c };
+    }
+
+    void teardown()
+    {
+        if (directory.empty())
+            return;
+
+        std::remove(sourceFile.c_str());
+        std::remove(executable.c_str());
+        std::remove(outputFile.c_str());
+        rmdir(directory.c_str());
+    }
+
+    bool createTmpDirectory()
+    {
+        const char *tmp = std::getenv("TMPDIR");
+        std::string pattern(tmp == nullptr ? "/tmp" : tmp);
+
+        pattern += "/tsym-codegen-XXXXXX";
+
+        if (mkdtemp(&pattern[0]) == nullptr)
+            return false;
+
+        directory = pattern;
+        sourceFile = directory + "/codegen-test.cpp";
+        executable = directory + "/codegen-test";
+        outputFile = directory + "/codegen-test.txt";
+
+        return true;
+    }
+
+    size_t count(const std::string& code, const std::string& pattern)
+    {
+        size_t n = 0;
+
+        for (size_t pos = code.find(pattern); pos != std::string::npos;
+                pos = code.find(pattern, pos + 1))
+            ++n;
+
+        return n;
+    }
+
+    double evalBySubstitution(const Var& expr)
+    {
+        Var result(expr);
+
+        for (size_t i = 0; i < symbols.size(); ++i)
+            result = result.subst(symbols[i], values[i]);
+
+        return result.getBasePtr()->numericEval().toDouble();
+    }
+
+    bool compilerAvailable()
+    {
+        return std::system("c++ --version > /dev/null 2>&1") == 0;
+    }
+
+    std::vector<double> compileAndRun(const std::string& code, const std::string& call,
+            size_t nResults)
+    {
+        const std::string command("c++ -std=c++11 -o " + executable + " " + sourceFile + " && " +
+                executable + " > " + outputFile);
+        std::ofstream source(sourceFile);
+        std::vector<double> results(nResults);
+
+        source << code << "\n#include <cstdio>\n\nint main()\n{\n";
+        source << "    const double args[] = { 0.3, 1.7, 2.2 };\n";
+        source << "    double result[" << nResults << "];\n\n";
+        source << "    " << call << ";\n\n";
+        source << "    for (int i = 0; i < " << nResults << "; ++i)\n";
+        source << "        std::printf(\"%.17g\\n\", result[i]);\n}\n";
+        source.close();
+
+        CHECK_EQUAL(0, std::system(command.c_str()));
+
+        std::ifstream output(outputFile);
+
+        for (auto& result : results)
+            output >> result;
+
+        return results;
+    }
+};
+
+TEST(CodeGen, scalarFunction)
+{
+    const std::string code(generateCode("f", a*b + 2, symbols));
+
+    CHECK(code.find("double f(const double *args)") != std::string::npos);
+    CHECK(code.find("return 2.0 + args[0]*args[1];") != std::string::npos);
+    CHECK_EQUAL(0, count(code, "#include"));
+}
+
+TEST(CodeGen, integerPowersAsMultiplication)
+{
+    const std::string code(generateCode("f", pow(a, 3) + pow(b, -2) + pow(c, 11), symbols));
+
+    CHECK_EQUAL(0, count(code, "std::pow"));
+    CHECK(code.find("args[0]*args[0]*args[0]") != std::string::npos);
+    CHECK(code.find("1.0/(args[1]*args[1])") != std::string::npos);
+}
+
+TEST(CodeGen, powOnlyForNonIntegerExponents)
+{
+    const std::string code(generateCode("f", pow(a, Var(2, 3)) + pow(a, b), symbols));
+
+    CHECK_EQUAL(2, count(code, "std::pow"));
+    CHECK_EQUAL(1, count(code, "#include <cmath>"));
+}
+
+TEST(CodeGen, sharedSubexpressionsAreHoisted)
+{
+    const Var shared(sqrt(a + b));
+    const Var expr(sin(shared)*c + cos(sin(shared)) + shared/c);
+    const std::string code(generateCode("f", expr, symbols));
+
+    CHECK_EQUAL(1, count(code, "std::sqrt"));
+    CHECK_EQUAL(1, count(code, "std::sin"));
+}
+
+TEST(CodeGen, sharedAcrossMatrixEntries)
+{
+    const Matrix m({ { sin(a)*b, sin(a)*c }, { sin(a) + 1, c } });
+    const std::string code(generateCode("m", m, symbols));
+
+    CHECK(code.find("void m(const double *args, double *result)") != std::string::npos);
+    CHECK_EQUAL(1, count(code, "std::sin"));
+    CHECK(code.find("result[3] = args[2];") != std::string::npos);
+}
+
+TEST(CodeGen, missingSymbolIsNaN)
+{
+    disableLog();
+    const std::string code(generateCode("f", a + Var("d"), { a }));
+    enableLog();
+
+    CHECK(code.find("quiet_NaN()") != std::string::npos);
+    CHECK(code.find("#include <limits>") != std::string::npos);
+}
+
+TEST(CodeGen, compiledVectorMatchesNumericEvaluation)
+    /* Requires a c++ compiler in the PATH, the test fails otherwise. */
+{
+    const Vector v({ pow(a, 7)*b - sqrt(c)/a, atan2(b, a)*log(c) + pow(c, Var(1, 3)),
+            -tan(a*b)*asin(a), pow(Euler, a)/(1 + pow(b, -5)) - Pi*acos(a) + atan(c)/cos(a) });
+    std::vector<double> results;
+
+    if (!compilerAvailable())
+        FAIL("No c++ compiler found to build the generated code");
+    else if (!createTmpDirectory())
+        FAIL("Couldn't create a temporary directory for the generated code");
+    else {
+        results = compileAndRun(generateCode("v", v, symbols), "v(args, result)", v.size());
+
+        for (size_t i = 0; i < v.size(); ++i)
+            DOUBLES_EQUAL(evalBySubstitution(v(i)), results[i], 1.e-12);
+    }
+}
@@ -0,0 +1,121 @@
+
+#include <sstream>
+#include "commonsubexpressions.h"
+#include "globals.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(CommonSubexpressions)
+{
+    Var a;
+    Var b;
+    Var c;
+
+    void setup()
+    {
+        a = Var("a");
+        b = Var("b");
+        c = Var("c");
+    }
+
+    Var substituteBack(const CommonSubexpressions& cse, Var expr)
+    {
+        const auto& tmps(cse.temporaries());
+
+        for (auto it = tmps.rbegin(); it != tmps.rend(); ++it)
+            expr = expr.subst(it->symbol, it->expr);
+
+        return expr;
+    }
+};
+
+TEST(CommonSubexpressions, nothingToEliminate)
+{
+    const Var expr(a*b + sin(c));
+    const CommonSubexpressions cse(expr);
+
+    CHECK(cse.temporaries().empty());
+    CHECK_EQUAL(1, cse.roots().size());
+    CHECK_EQUAL(expr, cse.roots().front());
+}
+
+TEST(CommonSubexpressions, repeatedFunction)
+{
+    const Var x1("x_1");
+    const CommonSubexpressions cse(sin(a*b)*c + cos(sin(a*b)));
+
+    CHECK_EQUAL(1, cse.temporaries().size());
+    CHECK_EQUAL(x1, cse.temporaries().front().symbol);
+    CHECK_EQUAL(sin(a*b), cse.temporaries().front().expr);
+    CHECK_EQUAL(x1*c + cos(x1), cse.roots().front());
+}
+
+TEST(CommonSubexpressions, nestedTemporariesInDependencyOrder)
+{
+    const Var inner(sqrt(a + b));
+    const Var outer(log(c*inner));
+    const CommonSubexpressions cse(outer*inner + outer/a);
+    const auto& tmps(cse.temporaries());
+
+    CHECK_EQUAL(2, tmps.size());
+    CHECK_EQUAL(inner, tmps[0].expr);
+    CHECK_EQUAL(log(c*tmps[0].symbol), tmps[1].expr);
+}
+
+TEST(CommonSubexpressions, sharedAcrossRoots)
+{
+    const Var shared(pow(a + b, c));
+    const CommonSubexpressions cse(std::vector<Var>{ shared*a, shared + b, c });
+
+    CHECK_EQUAL(1, cse.temporaries().size());
+    CHECK_EQUAL(3, cse.roots().size());
+    CHECK_EQUAL(cse.temporaries().front().symbol*a, cse.roots()[0]);
+    CHECK_EQUAL(c, cse.roots()[2]);
+}
+
+TEST(CommonSubexpressions, substitutionGivesOriginalExpressions)
+{
+    const Matrix m({ { a, b, 0 }, { c, a, 1 }, { 0, b, c } });
+    const Matrix inverse(m.inverse());
+    std::vector<Var> entries;
+
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 3; ++j)
+            entries.push_back(inverse(i, j));
+
+    const CommonSubexpressions cse(entries);
+
+    CHECK_FALSE(cse.temporaries().empty());
+
+    for (size_t i = 0; i < entries.size(); ++i)
+        CHECK_EQUAL(entries[i], substituteBack(cse, cse.roots()[i]));
+}
+
+TEST(CommonSubexpressions, namesOfInputAreSkipped)
+{
+    const Var t1("t_1");
+    const CommonSubexpressions cse(sin(a)*t1 + sin(a)*b, "t");
+
+    CHECK_EQUAL(1, cse.temporaries().size());
+    CHECK_EQUAL(Var("t_2"), cse.temporaries().front().symbol);
+}
+
+TEST(CommonSubexpressions, invalidPrefix)
+{
+    disableLog();
+    const CommonSubexpressions cse(sin(a) + b*sin(a), "1abc");
+    enableLog();
+
+    CHECK_EQUAL(Var("x_1"), cse.temporaries().front().symbol);
+}
+
+TEST(CommonSubexpressions, printing)
+{
+    const CommonSubexpressions cse(std::vector<Var>{ a*sin(b), sin(b) + c });
+    std::stringstream stream;
+
+    stream << cse;
+
+    CHECK_EQUAL("x_1 = sin(b)\na*x_1\nc + x_1\n", stream.str());
+}
@@ -0,0 +1,205 @@
+
+#include <cmath>
+#include <limits>
+#include "compiledvar.h"
+#include "globals.h"
+#include "baseptr.h"
+#include "base.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(CompiledVar)
+{
+    const double TOL = 1.e-12;
+    const std::vector<double> values { 0.3, 1.7, -0.8 };
+    Var a;
+    Var b;
+    Var c;
+    std::vector<Var> symbols;
+
+    void setup()
+    {
+        a = Var("a");
+        b = Var("b");
+        c = Var("c");
+
+        symbols = { a, b, c };
+    }
+
+    double evalBySubstitution(const Var& expr)
+    {
+        Var result(expr);
+
+        for (size_t i = 0; i < symbols.size(); ++i)
+            result = result.subst(symbols[i], values[i]);
+
+        return result.getBasePtr()->numericEval().toDouble();
+    }
+
+    void checkAgainstSubstitution(const Var& expr)
+    {
+        const CompiledVar compiled(compile(expr, symbols));
+
+        CHECK(compiled.isValid());
+        DOUBLES_EQUAL(evalBySubstitution(expr), compiled.evaluate(values.data()), TOL);
+    }
+
+    size_t countOps(const CompiledVar& compiled, CompiledVar::OpCode op)
+    {
+        size_t count = 0;
+
+        for (const auto& instruction : compiled.instructions())
+            if (instruction.op == op)
+                ++count;
+
+        return count;
+    }
+};
+
+TEST(CompiledVar, defaultConstructedIsNaN)
+{
+    const CompiledVar compiled;
+
+    CHECK(std::isnan(compiled.evaluate(nullptr)));
+}
+
+TEST(CompiledVar, numberAndConstant)
+{
+    DOUBLES_EQUAL(2.0/3.0, compile(Var(2, 3), {}).evaluate(nullptr), TOL);
+    DOUBLES_EQUAL(M_PI*M_E, compile(Pi*Euler, {}).evaluate(nullptr), TOL);
+}
+
+TEST(CompiledVar, singleSymbol)
+{
+    DOUBLES_EQUAL(values[1], compile(b, symbols).evaluate(values.data()), 0.0);
+}
+
+TEST(CompiledVar, sumsAndProducts)
+{
+    checkAgainstSubstitution(a + b - 2*c);
+    checkAgainstSubstitution(-a*b*c + Var(3, 4)*a/b);
+    checkAgainstSubstitution(a/(b*c*c) - 1/a);
+}
+
+TEST(CompiledVar, powers)
+{
+    checkAgainstSubstitution(pow(a, 7) + pow(b, -3) + sqrt(b) + 1/sqrt(b));
+    checkAgainstSubstitution(pow(b, a) + pow(b, Var(2, 3)) + pow(Euler, a*c));
+}
+
+TEST(CompiledVar, functions)
+{
+    checkAgainstSubstitution(sin(a) + cos(b) + tan(c) + asin(a) + acos(a) + atan(b));
+    checkAgainstSubstitution(atan2(a, b) + atan2(b, a) + log(b));
+}
+
+TEST(CompiledVar, atan2InAllQuadrants)
+{
+    const CompiledVar compiled(compile(atan2(a, b), { a, b }));
+    const double args[][2] = { { 0.3, 1.7 }, { 0.3, -1.7 }, { -0.3, -1.7 }, { -0.3, 1.7 } };
+
+    for (const auto& arg : args)
+        DOUBLES_EQUAL(std::atan2(arg[0], arg[1]), compiled.evaluate(arg), TOL);
+}
+
+TEST(CompiledVar, integerPowerWithoutPow)
+{
+    const CompiledVar compiled(compile(pow(a, 5)*pow(b, -2), symbols));
+
+    CHECK_EQUAL(0, countOps(compiled, CompiledVar::OpCode::POW));
+    CHECK_EQUAL(2, countOps(compiled, CompiledVar::OpCode::POWI));
+    DOUBLES_EQUAL(std::pow(0.3, 5)/(1.7*1.7), compiled.evaluate(values.data()), TOL);
+}
+
+TEST(CompiledVar, commonSubexpressionsAreEvaluatedOnce)
+{
+    const Var shared(sin(a*b));
+    const CompiledVar compiled(compile(shared*c + cos(shared) + shared, symbols));
+
+    CHECK_EQUAL(1, countOps(compiled, CompiledVar::OpCode::SIN));
+    CHECK_EQUAL(2, countOps(compiled, CompiledVar::OpCode::MUL));
+    checkAgainstSubstitution(shared*c + cos(shared) + shared);
+}
+
+TEST(CompiledVar, repeatedEvaluation)
+{
+    const CompiledVar compiled(compile(a*a + b, { a, b }));
+    double args[2];
+
+    for (int i = 0; i < 10; ++i) {
+        args[0] = i;
+        args[1] = 0.5*i;
+
+        DOUBLES_EQUAL(i*i + 0.5*i, compiled.evaluate(args), TOL);
+    }
+}
+
+TEST(CompiledVar, callerProvidedRegisters)
+{
+    const CompiledVar compiled(compile(sqrt(a + b)*c, symbols));
+    std::vector<double> registers(compiled.nRegisters());
+
+    DOUBLES_EQUAL(std::sqrt(2.0)*(-0.8), compiled.evaluate(values.data(), registers.data()), TOL);
+}
+
+TEST(CompiledVar, missingSymbol)
+{
+    disableLog();
+    const CompiledVar compiled(compile(a + Var("d"), symbols));
+    enableLog();
+
+    CHECK_FALSE(compiled.isValid());
+    CHECK(std::isnan(compiled.evaluate(values.data())));
+}
+
+TEST(CompiledVar, batchEqualsScalarEvaluation)
+{
+    const CompiledVar compiled(compile(pow(a, 3)*sqrt(b) - atan2(c, a) + sin(a*b)/cos(c) +
+                log(b)*tan(a) - pow(b, -2) + pow(b, a), symbols));
+    const size_t n = 23;
+    std::vector<double> input[3];
+    std::vector<double> results(n);
+    const double *args[] = { nullptr, nullptr, nullptr };
+
+    for (size_t j = 0; j < n; ++j) {
+        const double x = static_cast<double>(j);
+
+        input[0].push_back(0.1 + 0.05*x);
+        input[1].push_back(1.0 + 0.3*x);
+        input[2].push_back(-2.0 + 0.17*x);
+    }
+
+    for (size_t i = 0; i < 3; ++i)
+        args[i] = input[i].data();
+
+    compiled.evaluateBatch(args, n, results.data());
+
+    for (size_t j = 0; j < n; ++j) {
+        const double scalarArgs[] = { input[0][j], input[1][j], input[2][j] };
+
+        DOUBLES_EQUAL(compiled.evaluate(scalarArgs), results[j], TOL);
+    }
+}
+
+TEST(CompiledVar, batchWithoutArguments)
+{
+    const CompiledVar compiled(compile(Pi/2, {}));
+    std::vector<double> results(5, 0.0);
+
+    compiled.evaluateBatch(nullptr, results.size(), results.data());
+
+    for (const auto result : results)
+        DOUBLES_EQUAL(M_PI/2.0, result, TOL);
+}
+
+TEST(CompiledVar, emptyBatch)
+{
+    const CompiledVar compiled(compile(a, { a }));
+    const double *args[] = { nullptr };
+    double result = 42.0;
+
+    compiled.evaluateBatch(args, 0, &result);
+
+    DOUBLES_EQUAL(42.0, result, 0.0);
+}
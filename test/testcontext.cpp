@@ -0,0 +1,541 @@
+
+#include <random>
+#include <thread>
+#include "abc.h"
+#include "context.h"
+#include "contextdata.h"
+#include "symbol.h"
+#include "numeric.h"
+#include "numpowersimpl.h"
+#include "printer.h"
+#include "power.h"
+#include "product.h"
+#include "sum.h"
+#include "var.h"
+#include "globals.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(Context)
+{
+    Context *previous;
+
+    void setup()
+    {
+        previous = nullptr;
+    }
+
+    void teardown()
+    {
+        Context::install(previous);
+    }
+};
+
+TEST(Context, currentWithoutInstallation)
+{
+    Context& first(Context::current());
+    Context& second(Context::current());
+
+    CHECK(&first == &second);
+}
+
+TEST(Context, installAndUninstall)
+{
+    Context context;
+    Context& threadDefault(Context::current());
+
+    previous = Context::install(&context);
+
+    CHECK(&context == &Context::current());
+
+    Context::install(previous);
+
+    CHECK(&threadDefault == &Context::current());
+}
+
+TEST(Context, destructionUninstalls)
+{
+    Context& threadDefault(Context::current());
+
+    {
+        Context context;
+        previous = Context::install(&context);
+    }
+
+    CHECK(&threadDefault == &Context::current());
+}
+
+TEST(Context, printerSettingsAreIsolated)
+{
+    const BasePtr frac(Product::create(a, Power::oneOver(b)));
+    const std::string withoutFrac(Printer(frac).getStr());
+    const std::string withFrac("a/b");
+    Context context;
+
+    context.enableFractions();
+
+    previous = Context::install(&context);
+
+    CHECK_EQUAL(withFrac, Printer(frac).getStr());
+
+    Context::install(previous);
+
+    CHECK_EQUAL(withoutFrac, Printer(frac).getStr());
+}
+
+TEST(Context, maxPrimeResolutionIsIsolated)
+{
+    const Int defaultLimit(NumPowerSimpl::getMaxPrimeResolution());
+    Context context;
+
+    context.setMaxPrimeResolution(10);
+
+    previous = Context::install(&context);
+
+    CHECK_EQUAL(10, NumPowerSimpl::getMaxPrimeResolution());
+
+    Context::install(previous);
+
+    CHECK_EQUAL(defaultLimit, NumPowerSimpl::getMaxPrimeResolution());
+}
+
+TEST(Context, staticSettersChangeDefaultsOfNewContexts)
+{
+    const bool defaultFractions = Context::current().fractionsEnabled();
+    const Int defaultLimit(NumPowerSimpl::getMaxPrimeResolution());
+    bool threadFractions = defaultFractions;
+    Int threadLimit;
+
+    Printer::enableFractions();
+    NumPowerSimpl::setMaxPrimeResolution(10);
+
+    std::thread([&threadFractions, &threadLimit]() {
+            threadFractions = Context::current().fractionsEnabled();
+            threadLimit = NumPowerSimpl::getMaxPrimeResolution(); }).join();
+
+    CHECK(Context().fractionsEnabled());
+    CHECK_EQUAL(10, Context().data().maxPrimeResolution);
+
+    if (!defaultFractions)
+        Printer::disableFractions();
+
+    NumPowerSimpl::setMaxPrimeResolution(defaultLimit);
+
+    CHECK(threadFractions);
+    CHECK_EQUAL(10, threadLimit);
+    CHECK_EQUAL(defaultFractions, Context().fractionsEnabled());
+}
+
+TEST(Context, cachesAreOwnedByContext)
+{
+    Context context;
+    Var sum;
+
+    previous = Context::install(&context);
+
+    sum = Var("a")/Var("b") + 1/(5*Var("b"));
+    sum.normal();
+
+    CHECK(context.data().normalCache.size() > 0);
+    CHECK(context.data().symbolPool.size() > 0);
+
+    context.clear();
+
+    CHECK_EQUAL(0, context.data().normalCache.size());
+    CHECK_EQUAL(0, context.data().gcdCache.size());
+    CHECK_EQUAL(0, context.data().symbolPool.size());
+}
+
+TEST(Context, expressionsOutliveContext)
+{
+    Var expanded;
+
+    {
+        Context context;
+
+        previous = Context::install(&context);
+
+        expanded = ((Var("a") + Var("b"))*Var("c")).expand();
+    }
+
+    CHECK_EQUAL(Var("a")*Var("c") + Var("b")*Var("c"), expanded);
+}
+
+TEST(Context, symbolsFromDifferentContextsAreEqual)
+{
+    Context context;
+    BasePtr symbol;
+
+    previous = Context::install(&context);
+
+    symbol = Symbol::create("a");
+
+    Context::install(previous);
+
+    CHECK_EQUAL(a, symbol);
+}
+
+TEST(Context, parseCacheDisabledByDefault)
+{
+    Context context;
+
+    previous = Context::install(&context);
+
+    parse("a*b + c");
+    parse("a*b + c");
+
+    CHECK_EQUAL(0, context.parseCacheStats().capacity);
+    CHECK_EQUAL(0, context.parseCacheStats().size);
+    CHECK_EQUAL(0, context.parseCacheStats().hits);
+}
+
+TEST(Context, parseCacheHitsAndMisses)
+{
+    const std::string source("a*b + sqrt(12)*c");
+    Context context;
+    Var first;
+    Var second;
+
+    previous = Context::install(&context);
+
+    context.setParseCacheCapacity(10);
+
+    first = parse(source);
+    second = parse(source);
+
+    CHECK_EQUAL(first, second);
+    CHECK_EQUAL(1, context.parseCacheStats().hits);
+    CHECK_EQUAL(1, context.parseCacheStats().misses);
+    CHECK_EQUAL(1, context.parseCacheStats().size);
+}
+
+TEST(Context, parseCacheEvictsLeastRecentlyUsed)
+{
+    Context context;
+
+    previous = Context::install(&context);
+
+    context.setParseCacheCapacity(2);
+
+    parse("a + 1");
+    parse("a + 2");
+    parse("a + 1");
+    parse("a + 3");
+
+    CHECK_EQUAL(2, context.parseCacheStats().size);
+    CHECK_EQUAL(1, context.parseCacheStats().evictions);
+
+    parse("a + 1");
+    CHECK_EQUAL(2, context.parseCacheStats().hits);
+
+    parse("a + 2");
+    CHECK_EQUAL(2, context.parseCacheStats().hits);
+}
+
+TEST(Context, parseCacheIgnoresErroneousInput)
+{
+    Context context;
+    bool success = true;
+
+    previous = Context::install(&context);
+
+    context.setParseCacheCapacity(10);
+
+    disableLog();
+    parse("a*(b + c", &success);
+    CHECK_FALSE(success);
+
+    success = true;
+    parse("a*(b + c", &success);
+    enableLog();
+
+    CHECK_FALSE(success);
+    CHECK_EQUAL(0, context.parseCacheStats().size);
+    CHECK_EQUAL(0, context.parseCacheStats().hits);
+}
+
+TEST(Context, parseCacheInvalidation)
+{
+    Context context;
+
+    previous = Context::install(&context);
+
+    context.setParseCacheCapacity(10);
+
+    CHECK_EQUAL(2*sqrt(Var(2)), parse("sqrt(8)"));
+
+    context.clearParseCache();
+    CHECK_EQUAL(0, context.parseCacheStats().size);
+
+    parse("sqrt(8)");
+    context.setMaxPrimeResolution(1);
+
+    CHECK_EQUAL(0, context.parseCacheStats().size);
+    CHECK_EQUAL(Var(8).toThe(Var(1, 2)), parse("sqrt(8)"));
+}
+
+TEST(Context, parseCacheShrinksWithCapacity)
+{
+    Context context;
+
+    previous = Context::install(&context);
+
+    context.setParseCacheCapacity(10);
+
+    parse("a");
+    parse("b");
+    parse("c");
+
+    context.setParseCacheCapacity(1);
+
+    CHECK_EQUAL(1, context.parseCacheStats().size);
+    CHECK_EQUAL(2, context.parseCacheStats().evictions);
+}
+
+TEST(Context, diffCacheDefaultCapacity)
+{
+    Context context;
+
+    CHECK_EQUAL(10000, context.diffCacheStats().capacity);
+    CHECK_EQUAL(0, context.diffCacheStats().size);
+}
+
+TEST(Context, diffCacheHitsForRepeatedDiff)
+{
+    const Var a("a");
+    const Var expr(a*sin(a*a) + 2*a);
+    Context context;
+    Var first;
+
+    previous = Context::install(&context);
+
+    first = expr.diff(a);
+
+    CHECK_EQUAL(0, context.diffCacheStats().hits);
+    CHECK(context.diffCacheStats().size > 0);
+
+    CHECK_EQUAL(first, expr.diff(a));
+    CHECK_EQUAL(1, context.diffCacheStats().hits);
+}
+
+TEST(Context, diffCacheReusesNestedDerivatives)
+{
+    const Var a("a");
+    const Var b("b");
+    const Var shared(sin(a*b));
+    Context context;
+
+    previous = Context::install(&context);
+
+    shared.diff(a);
+    CHECK_EQUAL(0, context.diffCacheStats().hits);
+
+    (a + shared).diff(a);
+    CHECK_EQUAL(1, context.diffCacheStats().hits);
+}
+
+TEST(Context, diffCacheIgnoresLeafs)
+{
+    const Var a("a");
+    Context context;
+
+    previous = Context::install(&context);
+
+    a.diff(a);
+    Var(2).diff(a);
+
+    CHECK_EQUAL(0, context.diffCacheStats().size);
+    CHECK_EQUAL(0, context.diffCacheStats().misses);
+}
+
+TEST(Context, diffCacheDisabled)
+{
+    const Var a("a");
+    const Var expr(a*a*a + a);
+    Context context;
+
+    previous = Context::install(&context);
+
+    context.setDiffCacheCapacity(0);
+
+    CHECK_EQUAL(3*a*a + 1, expr.diff(a));
+    CHECK_EQUAL(3*a*a + 1, expr.diff(a));
+
+    CHECK_EQUAL(0, context.diffCacheStats().size);
+    CHECK_EQUAL(0, context.diffCacheStats().hits);
+}
+
+TEST(Context, diffCacheInvalidation)
+{
+    const Var a("a");
+    Context context;
+
+    previous = Context::install(&context);
+
+    sqrt(a).diff(a);
+    CHECK(context.diffCacheStats().size > 0);
+
+    context.clearDiffCache();
+    CHECK_EQUAL(0, context.diffCacheStats().size);
+
+    sqrt(a).diff(a);
+    context.clear();
+    CHECK_EQUAL(0, context.diffCacheStats().size);
+}
+
+TEST(Context, expansionSettings)
+{
+    Context context;
+
+    CHECK_EQUAL(1, context.expansionThreads());
+    CHECK_EQUAL(10000, context.parallelExpansionThreshold());
+
+    context.setExpansionThreads(0);
+    CHECK_EQUAL(1, context.expansionThreads());
+
+    context.setExpansionThreads(8);
+    context.setParallelExpansionThreshold(100);
+
+    CHECK_EQUAL(8, context.expansionThreads());
+    CHECK_EQUAL(100, context.parallelExpansionThreshold());
+}
+
+TEST(Context, normalizationSettings)
+{
+    Context context;
+
+    CHECK_EQUAL(1, context.normalizationThreads());
+    CHECK_EQUAL(16, context.parallelNormalizationThreshold());
+
+    context.setNormalizationThreads(0);
+    CHECK_EQUAL(1, context.normalizationThreads());
+
+    context.setNormalizationThreads(4);
+    context.setParallelNormalizationThreshold(2);
+
+    CHECK_EQUAL(4, context.normalizationThreads());
+    CHECK_EQUAL(2, context.parallelNormalizationThreshold());
+}
+
+TEST(Context, parallelInverseThreshold)
+{
+    Context context;
+
+    CHECK_EQUAL(8, context.parallelInverseThreshold());
+
+    context.setParallelInverseThreshold(3);
+
+    CHECK_EQUAL(3, context.parallelInverseThreshold());
+    CHECK_EQUAL(16, context.parallelNormalizationThreshold());
+}
+
+TEST(Context, zeroTestErrorBound)
+{
+    Context context;
+
+    DOUBLES_EQUAL(1e-12, context.zeroTestErrorBound(), 1e-24);
+
+    context.setZeroTestErrorBound(1e-30);
+
+    DOUBLES_EQUAL(1e-30, context.zeroTestErrorBound(), 1e-42);
+}
+
+TEST(Context, zeroTestIsReproducible)
+{
+    const Var zero = pow(Var("a") + Var("b"), 2) - (Var("a") + Var("b"))*(Var("b") + Var("a"));
+    std::mt19937_64 afterFirstRun;
+    Context context;
+
+    previous = Context::install(&context);
+
+    context.setZeroTestSeed(42);
+    CHECK(zero.isZeroProbabilistic());
+    afterFirstRun = context.data().zeroTestGenerator;
+
+    context.setZeroTestSeed(42);
+    CHECK(zero.isZeroProbabilistic());
+
+    CHECK(afterFirstRun == context.data().zeroTestGenerator);
+    CHECK(std::mt19937_64(42) != afterFirstRun);
+}
+
+TEST(Context, tmpSymbolsReleasedInOtherContext)
+{
+    BasePtr fromFirst(Symbol::createTmpSymbol());
+    Context context;
+    BasePtr t1;
+    BasePtr t2;
+    BasePtr t3;
+
+    previous = Context::install(&context);
+
+    t1 = Symbol::createTmpSymbol();
+    t2 = Symbol::createTmpSymbol();
+
+    fromFirst = Numeric::zero();
+
+    t3 = Symbol::createTmpSymbol();
+
+    CHECK(t3->isDifferent(t1));
+    CHECK(t3->isDifferent(t2));
+}
+
+TEST(Context, tmpSymbolsOfDifferentContextsDiffer)
+{
+    const BasePtr fromFirst(Symbol::createTmpSymbol());
+    Context context;
+    BasePtr fromSecond;
+
+    previous = Context::install(&context);
+
+    fromSecond = Symbol::createTmpSymbol();
+
+    CHECK(fromFirst->isDifferent(fromSecond));
+}
+
+TEST(Context, tmpSymbolsOutliveContext)
+{
+    BasePtr tmp;
+    BasePtr other;
+
+    {
+        Context context;
+
+        previous = Context::install(&context);
+        tmp = Symbol::createTmpSymbol();
+        other = Symbol::createTmpSymbol();
+
+        Context::install(previous);
+    }
+
+    tmp = Numeric::zero();
+    other = Symbol::createTmpSymbol();
+
+    CHECK(other->isSymbol());
+}
+
+TEST(Context, maxPrimeResolutionOfNumPowerSimplClearsCaches)
+{
+    const Int defaultLimit(NumPowerSimpl::getMaxPrimeResolution());
+    const Var a("a");
+    Context context;
+
+    previous = Context::install(&context);
+
+    context.setParseCacheCapacity(10);
+
+    CHECK_EQUAL(2*sqrt(Var(2)), parse("sqrt(8)"));
+    (a*sqrt(Var(8))).diff(a);
+
+    CHECK_EQUAL(1, context.parseCacheStats().size);
+    CHECK(context.diffCacheStats().size > 0);
+
+    NumPowerSimpl::setMaxPrimeResolution(1);
+
+    CHECK_EQUAL(0, context.parseCacheStats().size);
+    CHECK_EQUAL(0, context.diffCacheStats().size);
+    CHECK_EQUAL(Var(8).toThe(Var(1, 2)), parse("sqrt(8)"));
+
+    NumPowerSimpl::setMaxPrimeResolution(defaultLimit);
+}
@@ -0,0 +1,35 @@
+
+#ifdef TSYM_DEBUG_STRINGS
+
+#include "debugstring.h"
+#include "var.h"
+#include "baseptr.h"
+#include "base.h"
+#include "number.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(DebugString) {};
+
+TEST(DebugString, expression)
+{
+    const Var expr(Var("a")*Var("b") + 2);
+    const BasePtr& ptr(expr.getBasePtr());
+
+    CHECK_EQUAL("2 + a*b", std::string(tsym_debugStringBase(&*ptr)));
+}
+
+TEST(DebugString, number)
+{
+    const Number n(-2, 3);
+
+    CHECK_EQUAL("-2/3", std::string(tsym_debugStringNumber(&n)));
+}
+
+TEST(DebugString, nullPointer)
+{
+    CHECK_EQUAL("nullptr", std::string(tsym_debugStringBase(nullptr)));
+}
+
+#endif
@@ -0,0 +1,148 @@
+#include "abc.h"
+#include "densepoly.h"
+#include "sparsepoly.h"
+#include "sum.h"
+#include "product.h"
+#include "power.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(DensePoly)
+{
+    BasePtrList vars;
+
+    void setup()
+    {
+        vars = BasePtrList(a);
+    }
+
+    DensePoly convert(const BasePtr& ptr)
+    {
+        SparsePoly sparse;
+        DensePoly result;
+
+        CHECK(SparsePoly::fromBasePtr(ptr, vars, sparse));
+        CHECK(DensePoly::fromSparse(sparse, result));
+
+        return result;
+    }
+
+    DensePoly alternating(size_t nCoeffs, int offset)
+    {
+        std::vector<Number> coeffs;
+        int num;
+        int denom;
+
+        for (size_t i = 0; i < nCoeffs; ++i) {
+            num = static_cast<int>(i % 7) - 3 + offset;
+            denom = 1 + static_cast<int>(i % 3);
+            coeffs.push_back(Number(num, denom));
+        }
+
+        return DensePoly(coeffs);
+    }
+};
+
+TEST(DensePoly, trailingZerosAreRemoved)
+{
+    const DensePoly poly({ 1, 2, 0, 0 });
+
+    CHECK_EQUAL(1, poly.degree());
+    CHECK_EQUAL(2, poly.coeffs().size());
+    CHECK_EQUAL(Number(2), poly.leadingCoeff());
+    CHECK(DensePoly({ 0, 0 }).isZero());
+}
+
+TEST(DensePoly, conversionRoundTrip)
+{
+    const BasePtr ptr = Sum::create(Product::create(Numeric::create(2, 3), Power::create(a, five)),
+            Product::minus(a), seven);
+    const DensePoly poly(convert(ptr));
+
+    CHECK_EQUAL(5, poly.degree());
+    CHECK_EQUAL(ptr, poly.toSparse(1).toBasePtr(vars));
+}
+
+TEST(DensePoly, multivariateSparseInputFails)
+{
+    SparsePoly sparse;
+    DensePoly result;
+
+    CHECK(SparsePoly::fromBasePtr(Sum::create(a, b), BasePtrList(a, b), sparse));
+    CHECK_FALSE(DensePoly::fromSparse(sparse, result));
+}
+
+TEST(DensePoly, addAndSubtract)
+{
+    const DensePoly p1(convert(Sum::create(Power::create(a, three), a)));
+    const DensePoly p2(convert(Sum::create(Power::create(a, three), one)));
+
+    CHECK(convert(Sum::create(a, Numeric::mOne())) == p1 - p2);
+    CHECK(convert(Sum::create(Product::create(two, Power::create(a, three)), a, one)) == p1 + p2);
+    CHECK((p1 - p1).isZero());
+}
+
+TEST(DensePoly, schoolbookMultiplication)
+{
+    const DensePoly p1(convert(Sum::create(a, two)));
+    const DensePoly p2(convert(Sum::create(a, Numeric::create(-3))));
+
+    CHECK(convert(Sum::create(Power::create(a, two), Product::minus(a), Numeric::create(-6))) ==
+            p1*p2);
+    CHECK((p1*DensePoly()).isZero());
+}
+
+TEST(DensePoly, karatsubaEqualsSparseMultiplication)
+    /* Factors of different length above the threshold, such that the longer one is split. */
+{
+    const DensePoly p1(alternating(150, 0));
+    const DensePoly p2(alternating(61, 1));
+    const SparsePoly expected(p1.toSparse(1)*p2.toSparse(1));
+
+    CHECK(expected == (p1*p2).toSparse(1));
+    CHECK(expected == (p2*p1).toSparse(1));
+}
+
+TEST(DensePoly, divideWithRemainder)
+    /* (3*a^3 - 5*a^2 + 10*a - 3)/(3a + 1): quotient a^2 - 2a + 4, remainder -7. */
+{
+    const DensePoly u({ -3, 10, -5, 3 });
+    const DensePoly v({ 1, 3 });
+    DensePoly quotient;
+    DensePoly remainder;
+
+    u.divide(v, quotient, remainder);
+
+    CHECK(DensePoly({ 4, -2, 1 }) == quotient);
+    CHECK(DensePoly({ -7 }) == remainder);
+}
+
+TEST(DensePoly, divideByHigherDegree)
+{
+    const DensePoly u({ 1, 1 });
+    DensePoly quotient;
+    DensePoly remainder;
+
+    u.divide(DensePoly({ 1, 0, 1 }), quotient, remainder);
+
+    CHECK(quotient.isZero());
+    CHECK(u == remainder);
+}
+
+TEST(DensePoly, pseudoDivideEqualsSparse)
+{
+    const DensePoly u(alternating(12, 2));
+    const DensePoly v(alternating(5, -1));
+    SparsePoly sparseQuotient;
+    SparsePoly sparseRemainder;
+    DensePoly quotient;
+    DensePoly remainder;
+
+    u.toSparse(1).pseudoDivide(v.toSparse(1), 0, sparseQuotient, sparseRemainder);
+    u.pseudoDivide(v, quotient, remainder);
+
+    CHECK(sparseQuotient == quotient.toSparse(1));
+    CHECK(sparseRemainder == remainder.toSparse(1));
+    CHECK(sparseRemainder == u.pseudoRemainder(v).toSparse(1));
+}
@@ -0,0 +1,119 @@
+#include "derivatives.h"
+#include "globals.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(Derivatives)
+{
+    Var a;
+    Var b;
+    Var c;
+
+    void setup()
+    {
+        a = Var("a");
+        b = Var("b");
+        c = Var("c");
+    }
+
+    void checkEqual(const Var& expected, const Var& result)
+    {
+        CHECK_EQUAL(0, (expected - result).normal());
+    }
+};
+
+TEST(Derivatives, gradientOfPolynomial)
+{
+    const Var expr(a*a*b + 3*b*c + pow(c, 4));
+    const Vector grad(gradient(expr, { a, b, c }));
+
+    CHECK_EQUAL(3, grad.size());
+    checkEqual(2*a*b, grad(0));
+    checkEqual(a*a + 3*c, grad(1));
+    checkEqual(3*b + 4*pow(c, 3), grad(2));
+}
+
+TEST(Derivatives, gradientEqualsDiff)
+{
+    const Var shared(sin(a*b) + sqrt(c));
+    const Var expr(pow(shared, 3) + log(shared)*atan2(b, c) + tan(a)*acos(c/2) + pow(Euler, a*c));
+    const std::vector<Var> symbols { a, b, c };
+    const Vector grad(gradient(expr, symbols));
+
+    for (size_t i = 0; i < symbols.size(); ++i)
+        checkEqual(expr.diff(symbols[i]), grad(i));
+}
+
+TEST(Derivatives, gradientOfSymbolicPower)
+{
+    const Var expr(pow(a, b*c));
+    const Vector grad(gradient(expr, { a, b }));
+
+    checkEqual(expr.diff(a), grad(0));
+    checkEqual(expr.diff(b), grad(1));
+}
+
+TEST(Derivatives, independentSymbol)
+{
+    const Vector grad(gradient(sin(a) + b, { a, c, b }));
+
+    checkEqual(cos(a), grad(0));
+    CHECK_EQUAL(0, grad(1));
+    CHECK_EQUAL(1, grad(2));
+}
+
+TEST(Derivatives, gradientWrtNonSymbol)
+{
+    disableLog();
+    const Vector grad(gradient(a*b, { a, 2*b }));
+    enableLog();
+
+    CHECK_EQUAL(b, grad(0));
+    CHECK_EQUAL(Var::Type::UNDEFINED, grad(1).type());
+}
+
+TEST(Derivatives, jacobian)
+{
+    const Vector functions { a*b*c, sin(a) + cos(b), pow(a + c, 2) };
+    const std::vector<Var> symbols { a, b, c };
+    const Matrix jac(jacobian(functions, symbols));
+
+    CHECK_EQUAL(3, jac.rowSize());
+    CHECK_EQUAL(3, jac.colSize());
+
+    for (size_t i = 0; i < functions.size(); ++i)
+        for (size_t j = 0; j < symbols.size(); ++j)
+            checkEqual(functions(i).diff(symbols[j]), jac(i, j));
+}
+
+TEST(Derivatives, jacobianNonSquare)
+{
+    const Vector functions { a*b, b*c };
+    const Matrix jac(jacobian(functions, { a, b, c }));
+
+    CHECK_EQUAL(2, jac.rowSize());
+    CHECK_EQUAL(3, jac.colSize());
+    CHECK_EQUAL(b, jac(0, 0));
+    CHECK_EQUAL(0, jac(0, 2));
+    CHECK_EQUAL(b, jac(1, 2));
+}
+
+TEST(Derivatives, hessian)
+{
+    const Var expr(a*a*b + sin(b*c) + a/c);
+    const std::vector<Var> symbols { a, b, c };
+    const Matrix hess(hessian(expr, symbols));
+
+    for (size_t i = 0; i < symbols.size(); ++i)
+        for (size_t j = 0; j < symbols.size(); ++j) {
+            checkEqual(expr.diff(symbols[i]).diff(symbols[j]), hess(i, j));
+            CHECK_EQUAL(hess(i, j), hess(j, i));
+        }
+}
+
+TEST(Derivatives, emptySymbols)
+{
+    CHECK_EQUAL(0, gradient(a*b, {}).size());
+    CHECK_EQUAL(0, hessian(a*b, {}).rowSize());
+}
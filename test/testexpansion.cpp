@@ -6,6 +6,7 @@
 #include "power.h"
 #include "constant.h"
 #include "trigonometric.h"
+#include "context.h"
 #include "tsymtests.h"
 
 using namespace tsym;
@@ -332,3 +333,93 @@ TEST(Expansion, sumsOfPowersWithIntExp)
 
     CHECK_EQUAL(orig, result);
 }
+
+TEST(Expansion, largeIntegerPolynomials)
+    /* The product of the expanded sums is computed by Kronecker substitution, the result must be
+     * identical to the sum of all pairwise products. */
+{
+    const BasePtr p1 = Power::create(Sum::create(a, b, c, one), five)->expand();
+    const BasePtr p2 = Power::create(Sum::create(a, Product::minus(two, b), three), four)->expand();
+    BasePtrList summands;
+
+    for (const auto& u : p1->operands())
+        for (const auto& v : p2->operands())
+            summands.push_back(Product::create(u, v));
+
+    CHECK_EQUAL(Sum::create(summands), Product::create(p1, p2)->expand());
+}
+
+TEST(Expansion, multinomialOfFourSummands)
+    /* The power is expanded by the multinomial theorem, the result must be identical to the sum of
+     * all pairwise products of the expanded cube. */
+{
+    const BasePtr sum = Sum::create(a, Product::create(two, b), Product::minus(c, d), three);
+    const BasePtr cube = Power::create(sum, three)->expand();
+    BasePtrList summands;
+
+    for (const auto& u : cube->operands())
+        for (const auto& v : cube->operands())
+            summands.push_back(Product::create(u, v));
+
+    CHECK_EQUAL(Sum::create(summands), Power::create(sum, six)->expand());
+}
+
+TEST(Expansion, multinomialWithNumericPowers)
+    /* (sqrt(2) + a)^4 = a^4 + 4*sqrt(2)*a^3 + 12*a^2 + 8*sqrt(2)*a + 4. */
+{
+    const BasePtr sqrtTwo = Power::sqrt(two);
+    const BasePtr orig = Power::create(Sum::create(sqrtTwo, a), four);
+    const BasePtr expected = Sum::create({ Power::create(a, four),
+            Product::create(four, sqrtTwo, Power::create(a, three)),
+            Product::create(Numeric::create(12), Power::create(a, two)),
+            Product::create(eight, sqrtTwo, a), four });
+
+    CHECK_EQUAL(expected, orig->expand());
+}
+
+TEST(Expansion, multinomialWithNegativeExponent)
+{
+    const BasePtr orig = Power::create(Sum::create(a, b, c), Numeric::create(-2));
+    const BasePtr expected = Power::oneOver(Power::create(Sum::create(a, b, c), two)->expand());
+
+    CHECK_EQUAL(expected, orig->expand());
+}
+
+TEST(Expansion, manyMultinomialTermsByRepeatedMultiplication)
+    /* (1 + a + ... + a^9)^8 has too many terms of the multinomial theorem, which mostly coincide,
+     * so it is expanded by multiplication. */
+{
+    BasePtrList summands(one);
+    BasePtr result;
+
+    for (int i = 1; i < 10; ++i)
+        summands.push_back(Power::create(a, Numeric::create(i)));
+
+    result = Power::create(Sum::create(summands), eight)->expand();
+
+    CHECK(result->isSum());
+    CHECK_EQUAL(73, result->operands().size());
+    CHECK_EQUAL(72, result->degree(a));
+    CHECK_EQUAL(Numeric::create(100000000), result->subst(a, one));
+}
+
+TEST(Expansion, parallelExpansionOfProduct)
+{
+    const BasePtr sqrtTwo = Power::sqrt(two);
+    const BasePtr p1 = Power::create(Sum::create({ a, Product::create(sqrtTwo, b), c, d, e }),
+            three)->expand();
+    const BasePtr p2 = Power::create(Sum::create({ a, Product::minus(b, c), i, f, one }),
+            three)->expand();
+    const BasePtr sequential = Product::create(p1, p2)->expand();
+    Context context;
+    Context *previous;
+
+    context.setExpansionThreads(4);
+    context.setParallelExpansionThreshold(1);
+
+    previous = Context::install(&context);
+
+    CHECK_EQUAL(sequential, Product::create(p1, p2)->expand());
+
+    Context::install(previous);
+}
@@ -0,0 +1,212 @@
+
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include "filetovar.h"
+#include "context.h"
+#include "globals.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(FileToVar)
+{
+    const std::string filename = "misc/test-logfiles/filetovar-input.txt";
+    Var a;
+    Var b;
+    Var c;
+
+    void setup()
+    {
+        a = Var("a");
+        b = Var("b");
+        c = Var("c");
+    }
+
+    void teardown()
+    {
+        std::remove(filename.c_str());
+    }
+
+    void write(const std::string& content)
+    {
+        std::ofstream stream(filename);
+
+        stream << content;
+    }
+};
+
+TEST(FileToVar, nonExistingFile)
+{
+    disableLog();
+    const FileToVar ftv("misc/test-logfiles/non-existing-file.txt");
+    enableLog();
+
+    CHECK_FALSE(ftv.fileRead());
+    CHECK_FALSE(ftv.success());
+    CHECK_EQUAL(0, ftv.size());
+}
+
+TEST(FileToVar, emptyFile)
+{
+    write("");
+
+    const FileToVar ftv(filename);
+
+    CHECK(ftv.fileRead());
+    CHECK(ftv.success());
+    CHECK_EQUAL(0, ftv.size());
+}
+
+TEST(FileToVar, expressionsAndAssignments)
+{
+    write("a + b\n\n# Comment line\nx_1 = sin(a)*b\n   \nc^2/a\n");
+
+    const FileToVar ftv(filename);
+
+    CHECK(ftv.success());
+    CHECK_EQUAL(3, ftv.size());
+
+    CHECK(ftv[0].name.empty());
+    CHECK_EQUAL(a + b, ftv[0].expr);
+    CHECK_EQUAL(1, ftv[0].line);
+
+    CHECK_EQUAL("x_1", ftv[1].name);
+    CHECK_EQUAL(sin(a)*b, ftv[1].expr);
+    CHECK_EQUAL(4, ftv[1].line);
+
+    CHECK_EQUAL(c*c/a, ftv[2].expr);
+    CHECK_EQUAL(6, ftv[2].line);
+    CHECK_EQUAL(0, ftv[2].column);
+}
+
+TEST(FileToVar, lastLineWithoutNewlineAndCarriageReturns)
+{
+    write("a*b\r\nb - c\r\nc");
+
+    const FileToVar ftv(filename);
+
+    CHECK(ftv.success());
+    CHECK_EQUAL(3, ftv.size());
+    CHECK_EQUAL(a*b, ftv[0].expr);
+    CHECK_EQUAL(b - c, ftv[1].expr);
+    CHECK_EQUAL(c, ftv[2].expr);
+}
+
+TEST(FileToVar, errorsWithLineAndColumn)
+{
+    write("a + b\nres = a*(b + c\n1 = a\n");
+
+    disableLog();
+    const FileToVar ftv(filename);
+    enableLog();
+
+    CHECK(ftv.fileRead());
+    CHECK_FALSE(ftv.success());
+    CHECK_EQUAL(3, ftv.size());
+
+    CHECK(ftv[0].errors.empty());
+
+    CHECK_EQUAL(2, ftv[1].line);
+    CHECK_EQUAL(14, ftv[1].column);
+    CHECK_FALSE(ftv[1].errors.empty());
+
+    CHECK_EQUAL(3, ftv[2].line);
+    CHECK_EQUAL(1, ftv[2].column);
+    CHECK_EQUAL(a, ftv[2].expr);
+}
+
+TEST(FileToVar, iteration)
+{
+    Var sum;
+
+    write("a\nb\nc\n");
+
+    const FileToVar ftv(filename);
+
+    for (const auto& entry : ftv)
+        sum += entry.expr;
+
+    CHECK_EQUAL(a + b + c, sum);
+}
+
+TEST(FileToVar, streamingThroughCallback)
+{
+    std::vector<unsigned> lines;
+    Var product(1);
+
+    write("a\n\nb = sqrt(12)\nc\n");
+
+    CHECK(FileToVar::parse(filename, [&lines, &product](const FileToVar::Entry& entry) {
+                lines.push_back(entry.line);
+                product *= entry.expr;
+                }));
+
+    CHECK_EQUAL(3, lines.size());
+    CHECK_EQUAL(3, lines[1]);
+    CHECK_EQUAL(2*sqrt(Var(3))*a*c, product);
+}
+
+TEST(FileToVar, parallelParsingKeepsOrder)
+{
+    const size_t nLines = 100;
+    std::string content;
+
+    for (size_t i = 0; i < nLines; ++i)
+        content += "a^" + std::to_string(i) + " + b*" + std::to_string(i) + "\n";
+
+    write(content);
+
+    const FileToVar ftv(filename, 4);
+
+    CHECK(ftv.success());
+    CHECK_EQUAL(nLines, ftv.size());
+
+    for (size_t i = 0; i < nLines; ++i) {
+        const int n = static_cast<int>(i);
+
+        CHECK_EQUAL(i + 1, ftv[i].line);
+        CHECK_EQUAL(a.toThe(n) + n*b, ftv[i].expr);
+    }
+}
+
+TEST(FileToVar, parallelParsingWithErrors)
+    /* Every other line is invalid, such that the worker threads report errors concurrently. */
+{
+    const size_t nLines = 100;
+    std::string content;
+
+    for (size_t i = 0; i < nLines; ++i)
+        content += i % 2 == 0 ? "a*(b + " + std::to_string(i) + "\n" : "a + b\n";
+
+    write(content);
+
+    disableLog();
+    const FileToVar ftv(filename, 4);
+    enableLog();
+
+    CHECK_FALSE(ftv.success());
+    CHECK_EQUAL(nLines, ftv.size());
+
+    for (size_t i = 0; i < nLines; ++i) {
+        CHECK_EQUAL(i % 2 == 0, !ftv[i].errors.empty());
+        CHECK_EQUAL(i + 1, ftv[i].line);
+    }
+}
+
+TEST(FileToVar, parallelParsingUsesSettingsOfCallingThread)
+{
+    Context context;
+    Context *previous = Context::install(&context);
+
+    context.setMaxPrimeResolution(10);
+
+    write("sqrt(11*11*2)\nsqrt(11*11*2)\nsqrt(11*11*2)\n");
+
+    const FileToVar ftv(filename, 3);
+
+    for (const auto& entry : ftv)
+        CHECK_EQUAL(Var(Var(242).toThe(Var(1, 2))), entry.expr);
+
+    Context::install(previous);
+}
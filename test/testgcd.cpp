@@ -5,6 +5,8 @@
 #include "power.h"
 #include "primitivegcd.h"
 #include "subresultantgcd.h"
+#include "modulargcd.h"
+#include "heuristicgcd.h"
 #include "poly.h"
 #include "logging.h"
 #include "tsymtests.h"
@@ -28,6 +30,8 @@ TEST_GROUP(Gcd)
     {
         checkPrimitive(expected, u, v);
         checkSubresultant(expected, u, v);
+        checkModular(expected, u, v);
+        checkHeuristic(expected, u, v);
     }
 
     void checkPrimitive(const BasePtr& expected, const BasePtr& u, const BasePtr& v)
@@ -44,6 +48,20 @@ TEST_GROUP(Gcd)
         check(&srGcd, expected, u, v);
     }
 
+    void checkModular(const BasePtr& expected, const BasePtr& u, const BasePtr& v)
+    {
+        ModularGcd mGcd;
+
+        check(&mGcd, expected, u, v);
+    }
+
+    void checkHeuristic(const BasePtr& expected, const BasePtr& u, const BasePtr& v)
+    {
+        HeuristicGcd hGcd;
+
+        check(&hGcd, expected, u, v);
+    }
+
     void check(GcdStrategy *gcd, const BasePtr& expected, const BasePtr& u, const BasePtr& v)
     {
         const BasePtr result = poly::gcd(u, v, gcd);
@@ -383,3 +401,50 @@ TEST(Gcd, largeMultivarPoly)
 
     check(gcd, u, v);
 }
+
+TEST(Gcd, largeCoefficientsSeveralPrimes)
+    /* The coefficients of the gcd don't fit into one word-sized prime of the modular algorithm. */
+{
+    const BasePtr large = Numeric::create(Int("123456789012345678901234567890"));
+    const BasePtr gcd = Sum::create(Product::create(large, a, Power::create(b, two)),
+            Product::create(Numeric::create(-7), c), Numeric::create(Int("98765432109876543")));
+    const BasePtr u = Product::create(gcd, Sum::create(Product::create(two, a), c))->expand();
+    const BasePtr v = Product::create(gcd, Sum::create(b, Power::create(c, three)))->expand();
+
+    check(gcd, u, v);
+}
+
+TEST(Gcd, multivariateRationalCoefficients)
+    /* All algorithms return the same primitive gcd with integer coefficients. */
+{
+    const BasePtr gcd = Sum::create(a, Product::create(Numeric::create(2, 3), b, c));
+    const BasePtr u = Product::create(gcd, Sum::create(Product::create(Numeric::create(1, 5), a),
+                b))->expand();
+    const BasePtr v = Product::create(gcd, Power::create(Sum::create(a, c), two))->expand();
+    const BasePtr expected = Sum::create(Product::create(three, a), Product::create(two, b, c));
+
+    check(expected, u, v);
+}
+
+TEST(Gcd, heuristicFallbackForLargeDegree)
+    /* The evaluation would result in too large integers, the fallback algorithm is used. */
+{
+    const BasePtr large = Numeric::create(Int(10).toThe(60));
+    const BasePtr gcd = Sum::create(Power::create(a, Numeric::create(30)), large);
+    const BasePtr u = Product::create(gcd, Sum::create(a, two))->expand();
+    const BasePtr v = Product::create(gcd, Sum::create(a, three))->expand();
+
+    checkHeuristic(gcd, u, v);
+}
+
+TEST(Gcd, heuristicWithGivenFallback)
+{
+    const BasePtr large = Numeric::create(Int(10).toThe(60));
+    const BasePtr gcd = Sum::create(Power::create(a, Numeric::create(30)), large);
+    const BasePtr u = Product::create(gcd, Sum::create(a, two))->expand();
+    const BasePtr v = Product::create(gcd, Sum::create(a, three))->expand();
+    const PrimitiveGcd fallback;
+    const HeuristicGcd hGcd(&fallback);
+
+    CHECK_EQUAL(gcd, poly::gcd(u, v, &hGcd));
+}
@@ -352,6 +352,34 @@ TEST(Int, moduloZeroPosAndNegNumber)
     CHECK_EQUAL(0, -n % -2);
 }
 
+TEST(Int, bitLength)
+{
+    CHECK_EQUAL(0, Int(0).bitLength());
+    CHECK_EQUAL(1, Int(-1).bitLength());
+    CHECK_EQUAL(8, Int(255).bitLength());
+    CHECK_EQUAL(9, Int(-256).bitLength());
+    CHECK_EQUAL(201, Int(2).toThe(200).bitLength());
+}
+
+TEST(Int, gcd)
+{
+    const Int n(-84);
+
+    CHECK_EQUAL(12, n.gcd(36));
+    CHECK_EQUAL(12, n.gcd(-36));
+    CHECK_EQUAL(84, n.gcd(0));
+    CHECK_EQUAL(0, Int(0).gcd(0));
+}
+
+TEST(Int, gcdOfLargeNumbers)
+{
+    const Int factor("98763298472039487209348720");
+    const Int n = factor*Int("3298472908374");
+    const Int m = -factor*Int("9832749823749851");
+
+    CHECK_EQUAL(factor, n.gcd(m));
+}
+
 TEST(Int, illegalInputStr)
 {
     disableLog();
@@ -0,0 +1,96 @@
+#include "abc.h"
+#include "kronecker.h"
+#include "sum.h"
+#include "product.h"
+#include "power.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(Kronecker)
+{
+    BasePtrList vars;
+
+    void setup()
+    {
+        vars = BasePtrList{ a, b, c };
+    }
+
+    SparsePoly convert(const BasePtr& ptr)
+    {
+        SparsePoly result;
+
+        CHECK(SparsePoly::fromBasePtr(ptr, vars, result));
+
+        return result;
+    }
+
+    SparsePoly power(const BasePtr& base, int exp)
+    {
+        return convert(Power::create(base, Numeric::create(exp))->expand());
+    }
+
+    void checkProduct(const SparsePoly& u, const SparsePoly& v)
+    {
+        SparsePoly result;
+
+        CHECK(kroneckerMultiply(u, v, result));
+        CHECK(u*v == result);
+    }
+};
+
+TEST(Kronecker, univariate)
+{
+    checkProduct(power(Sum::create(a, two), 7), power(Sum::create(a, Numeric::create(-3)), 5));
+}
+
+TEST(Kronecker, cancellationToMonomials)
+{
+    const SparsePoly u(convert(Sum::create(a, one)));
+    const SparsePoly v(convert(Sum::create(a, Numeric::mOne())));
+
+    checkProduct(u, v);
+}
+
+TEST(Kronecker, negativeCoefficientsAndBorrow)
+    /* The product has coefficients with alternating sign next to zero ones. */
+{
+    const SparsePoly u(convert(Sum::create(Power::create(a, three), Numeric::mOne())));
+    const SparsePoly v(convert(Sum::create(Power::create(a, two), a, one)));
+
+    checkProduct(u, v);
+    checkProduct(-u, v);
+}
+
+TEST(Kronecker, multivariate)
+{
+    const BasePtr p1 = Sum::create(a, Product::create(two, b), Product::minus(c));
+    const BasePtr p2 = Sum::create(Product::create(a, c), Numeric::create(-3), b);
+
+    checkProduct(power(p1, 4), power(p2, 3));
+}
+
+TEST(Kronecker, largeCoefficients)
+{
+    const BasePtr large = Numeric::create(Int("-98765432109876543210987654321"));
+    const BasePtr p = Sum::create(Product::create(large, a, b), Product::create(seven, c), one);
+
+    checkProduct(power(p, 3), power(p, 2));
+}
+
+TEST(Kronecker, nonIntegerCoefficients)
+{
+    const SparsePoly u(convert(Sum::create(a, Numeric::create(1, 2))));
+    SparsePoly result;
+
+    CHECK_FALSE(kroneckerMultiply(u, u, result));
+}
+
+TEST(Kronecker, tooSparse)
+{
+    const SparsePoly u(convert(Sum::create(Power::create(a, Numeric::create(100)), one)));
+    const SparsePoly v(convert(Sum::create(Power::create(b, Numeric::create(100)), one)));
+    SparsePoly result;
+
+    CHECK_FALSE(kroneckerMultiply(u, v, result));
+}
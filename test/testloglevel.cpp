@@ -0,0 +1,72 @@
+
+#include "loglevel.h"
+#include "logging.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(LogLevel)
+{
+    unsigned nEvaluations = 0;
+
+    void teardown()
+    {
+        setLogLevel(LogLevel::DEBUG);
+    }
+
+    int countEvaluation()
+    {
+        ++nEvaluations;
+
+        return 0;
+    }
+};
+
+TEST(LogLevel, defaultLetsAllMessagesPass)
+{
+    CHECK(getLogLevel() == LogLevel::DEBUG);
+    CHECK(isLogEnabled(LogLevel::DEBUG));
+    CHECK(isLogEnabled(LogLevel::CRITICAL));
+}
+
+TEST(LogLevel, threshold)
+{
+    setLogLevel(LogLevel::WARNING);
+
+    CHECK(getLogLevel() == LogLevel::WARNING);
+    CHECK_FALSE(isLogEnabled(LogLevel::DEBUG));
+    CHECK_FALSE(isLogEnabled(LogLevel::INFO));
+    CHECK(isLogEnabled(LogLevel::WARNING));
+    CHECK(isLogEnabled(LogLevel::ERROR));
+}
+
+TEST(LogLevel, noneDisablesEverything)
+{
+    setLogLevel(LogLevel::NONE);
+
+    CHECK_FALSE(isLogEnabled(LogLevel::CRITICAL));
+    CHECK_FALSE(TSYM_LOG_ENABLED(TSYM_LOG_LEVEL_CRITICAL));
+}
+
+TEST(LogLevel, argumentsOfDisabledMessagesAreNotEvaluated)
+{
+    setLogLevel(LogLevel::ERROR);
+
+    TSYM_DEBUG("Debug message ", countEvaluation());
+    TSYM_INFO("Info message ", countEvaluation());
+    TSYM_WARNING("Warning message ", countEvaluation());
+
+    CHECK_EQUAL(0, nEvaluations);
+}
+
+TEST(LogLevel, macroAsSingleStatement)
+{
+    setLogLevel(LogLevel::NONE);
+
+    if (nEvaluations == 0)
+        TSYM_ERROR("Error message ", countEvaluation());
+    else
+        countEvaluation();
+
+    CHECK_EQUAL(0, nEvaluations);
+}
@@ -4,6 +4,7 @@
 #include "matrix.h"
 #include "globals.h"
 #include "logging.h"
+#include "context.h"
 #include "tsymtests.h"
 
 using namespace tsym;
@@ -856,6 +857,43 @@ TEST(Matrix, inverse3x3)
     }
 }
 
+TEST(Matrix, inverseWithPivoting)
+{
+    const Matrix A {{ 0, 1, a, 3 }, { b, 0, 2, 0 }, { a, Var(-1, 2), 0 , 2}, { 0, b, 3, 0 }};
+    const Matrix Ainv = A.inverse();
+    const Matrix one = A*Ainv;
+
+    for (size_t i = 0; i < 4; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            CHECK_EQUAL(i == j ? 1 : 0, one(i, j).normal());
+}
+
+TEST(Matrix, parallelInverse)
+{
+    Context context;
+    Context *previous;
+    Matrix expected;
+    Matrix A(3, 3);
+
+    A(0, 0) = a;
+    A(0, 2) = 2*b;
+    A(1, 0) = 10;
+    A(1, 2) = c*d;
+    A(2, 0) = a*a;
+    A(2, 1) = b + e;
+    A(2, 2) = 1;
+
+    expected = A.inverse();
+
+    context.setNormalizationThreads(3);
+    context.setParallelInverseThreshold(1);
+    previous = Context::install(&context);
+
+    CHECK_EQUAL(expected, A.inverse());
+
+    Context::install(previous);
+}
+
 TEST(Matrix, largeDoubleInverse)
 {
     const size_t size = 15;
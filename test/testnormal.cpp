@@ -7,6 +7,7 @@
 #include "product.h"
 #include "power.h"
 #include "symbolmap.h"
+#include "context.h"
 #include "tsymtests.h"
 
 using namespace tsym;
@@ -202,6 +203,44 @@ TEST(Normal, sum)
     CHECK_EQUAL(expected, result);
 }
 
+TEST(Normal, sumWithCommonFactorInDenominators)
+    /* a/((b + 1)*(b + 2)) + c/(b + 1) becomes (a + 2*c + b*c)/(2 + 3*b + b^2). */
+{
+    const BasePtr bPlusOne = Sum::create(b, one);
+    const BasePtr orig = Sum::create(Product::create(a, Power::oneOver(bPlusOne),
+                Power::oneOver(Sum::create(b, two))), Product::create(c,
+                    Power::oneOver(bPlusOne)));
+    const BasePtr expected = Product::create(Sum::create(a, Product::create(two, c),
+                Product::create(b, c)), Power::oneOver(Sum::create(two,
+                        Product::create(Numeric::create(3), b), Power::create(b, two))));
+
+    CHECK_EQUAL(expected, orig->normal());
+}
+
+TEST(Normal, sumWithRepeatedDenominators)
+    /* Summands over the denominators b + c and a + b alternate. */
+{
+    const BasePtr oneOverBc = Power::oneOver(Sum::create(b, c));
+    const BasePtr oneOverAb = Power::oneOver(Sum::create(a, b));
+    BasePtrList summands;
+    BasePtr expected;
+    BasePtr orig;
+
+    for (int k = 1; k <= 4; ++k) {
+        summands.push_back(Product::create(Power::create(a, Numeric::create(k)), oneOverBc));
+        summands.push_back(Product::create(Power::create(c, Numeric::create(k)), oneOverAb));
+    }
+
+    orig = Sum::create(summands);
+    expected = Product::create(Sum::create(Product::create(Sum::create(a, b),
+                    Sum::create(a, Power::create(a, two), Power::create(a, Numeric::create(3)),
+                        Power::create(a, Numeric::create(4)))), Product::create(Sum::create(b, c),
+                        Sum::create(c, Power::create(c, two), Power::create(c, Numeric::create(3)),
+                            Power::create(c, Numeric::create(4))))), oneOverBc, oneOverAb);
+
+    CHECK_EQUAL(expected->normal(), orig->normal());
+}
+
 TEST(Normal, longSimpleSum)
     /* (1/a)* (a + b - b*(c - (a + b)*c/a + d)/(-b*c/a + d)) becomes 1. */
 {
@@ -391,3 +430,32 @@ TEST(Normal, tanInDenominator)
 
     CHECK_EQUAL(expected, result);
 }
+
+TEST(Normal, parallelNormalization)
+    /* Sum of a^k/(b + k) for k = 1, ..., 12, sqrt(2)/(a + b) and sin(a)/b, where the last two
+     * summands can't be normalized independently of the others. */
+{
+    BasePtrList summands;
+    Context context;
+    Context *previous;
+    BasePtr orig;
+    BasePtr expected;
+
+    for (int k = 1; k <= 12; ++k)
+        summands.push_back(Product::create(Power::create(a, Numeric::create(k)),
+                    Power::oneOver(Sum::create(b, Numeric::create(k)))));
+
+    summands.push_back(Product::create(Power::sqrt(two), Power::oneOver(Sum::create(a, b))));
+    summands.push_back(Product::create(Trigonometric::createSin(a), Power::oneOver(b)));
+
+    orig = Sum::create(summands);
+    expected = orig->normal();
+
+    context.setNormalizationThreads(4);
+    context.setParallelNormalizationThreshold(2);
+    previous = Context::install(&context);
+
+    CHECK_EQUAL(expected, orig->normal());
+
+    Context::install(previous);
+}
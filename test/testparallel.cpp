@@ -0,0 +1,83 @@
+#include <mutex>
+#include <set>
+#include <vector>
+#include "abc.h"
+#include "parallel.h"
+#include "context.h"
+#include "contextdata.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(Parallel) {};
+
+TEST(Parallel, everyTaskRunsOnce)
+{
+    std::vector<int> count(100, 0);
+
+    runInParallel(count.size(), 4, [&](size_t i, unsigned) { ++count[i]; });
+
+    for (const auto n : count)
+        CHECK_EQUAL(1, n);
+}
+
+TEST(Parallel, threadIndicesInRange)
+{
+    std::vector<unsigned> threads(50, 0);
+
+    runInParallel(threads.size(), 3, [&](size_t i, unsigned thread) { threads[i] = thread; });
+
+    for (const auto thread : threads)
+        CHECK(thread < 3);
+}
+
+TEST(Parallel, noTasks)
+{
+    bool called = false;
+
+    runInParallel(0, 4, [&](size_t, unsigned) { called = true; });
+
+    CHECK_FALSE(called);
+}
+
+TEST(Parallel, callingThreadKeepsItsContext)
+{
+    Context& current(Context::current());
+    std::mutex mutex;
+    std::set<const Context*> contexts;
+
+    runInParallel(8, 1, [&](size_t, unsigned) {
+            std::lock_guard<std::mutex> lock(mutex);
+            contexts.insert(&Context::current());
+            });
+
+    CHECK_EQUAL(1, contexts.size());
+    CHECK(&current == *contexts.begin());
+}
+
+TEST(Parallel, otherThreadsUseSettingsOfCallingThread)
+{
+    std::vector<int> fractions(16, -1);
+    std::vector<unsigned> nestedThreads(16, 0);
+    Context context;
+    Context *previous;
+
+    context.disableFractions();
+    context.setNormalizationThreads(4);
+    previous = Context::install(&context);
+
+    runInParallel(fractions.size(), 4, [&](size_t i, unsigned thread) {
+            const ContextData& data(Context::current().data());
+
+            fractions[i] = data.fractions ? 1 : 0;
+            /* No nested parallelism in the additional threads: */
+            nestedThreads[i] = thread == 0 ? 1 : data.normalizationThreads;
+            });
+
+    Context::install(previous);
+
+    for (size_t i = 0; i < fractions.size(); ++i) {
+        CHECK_EQUAL(0, fractions[i]);
+        CHECK_EQUAL(1, nestedThreads[i]);
+    }
+}
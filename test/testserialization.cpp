@@ -0,0 +1,253 @@
+
+#include <cstdio>
+#include "serialization.h"
+#include "globals.h"
+#include "symbol.h"
+#include "sum.h"
+#include "undefined.h"
+#include "dagformat.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(Serialization)
+{
+    const std::string filename = "misc/test-logfiles/serialization-input.bin";
+    Var a;
+    Var b;
+    Var c;
+
+    void setup()
+    {
+        a = Var("a");
+        b = Var("b");
+        c = Var("c");
+    }
+
+    void teardown()
+    {
+        std::remove(filename.c_str());
+    }
+
+    void checkRoundTrip(const Var& expr)
+    {
+        bool success = false;
+        const Var result(deserialize(serialize(expr), &success));
+
+        CHECK(success);
+        CHECK_EQUAL(expr, result);
+    }
+
+    const Base *address(const Var& expr)
+    {
+        return &*expr.getBasePtr();
+    }
+};
+
+TEST(Serialization, integers)
+{
+    checkRoundTrip(0);
+    checkRoundTrip(1);
+    checkRoundTrip(-12345);
+    checkRoundTrip(Var("123456789012345678901234567890123456789"));
+    checkRoundTrip(-Var("98765432109876543210987654321"));
+}
+
+TEST(Serialization, fractions)
+{
+    checkRoundTrip(Var(2, 3));
+    checkRoundTrip(Var(-17, 4));
+    checkRoundTrip(Var("123456789012345678901234567890")/Var("98765432109876543211"));
+}
+
+TEST(Serialization, doubles)
+{
+    checkRoundTrip(1.23456789e-200);
+    checkRoundTrip(-3.14159265358979);
+}
+
+TEST(Serialization, symbolsAndConstants)
+{
+    checkRoundTrip(a);
+    checkRoundTrip(Var("a", Var::Sign::POSITIVE));
+    checkRoundTrip(Var("a_{12}"));
+    checkRoundTrip(Var(Symbol::create(Name("b", "1", "2"))));
+    checkRoundTrip(Pi);
+    checkRoundTrip(Euler);
+}
+
+TEST(Serialization, positiveFlagIsRestored)
+{
+    const Var positive("a", Var::Sign::POSITIVE);
+    const Var result(deserialize(serialize(positive)));
+
+    CHECK(result.isPositive());
+    CHECK(result != a);
+}
+
+TEST(Serialization, compositeExpressions)
+{
+    checkRoundTrip(a + b*c - 2*sqrt(Var(3))*a*a);
+    checkRoundTrip(pow(a + b, Var(2, 3))/c);
+    checkRoundTrip(sin(a) + cos(b) + tan(c) + asin(a*b) + acos(a/b) + atan(c*c));
+    checkRoundTrip(atan2(a, b*c) + log(a + Pi) - Euler*b);
+}
+
+TEST(Serialization, undefined)
+{
+    bool success = false;
+    const Var result(deserialize(serialize(Var(Undefined::create())), &success));
+
+    CHECK(success);
+    CHECK_EQUAL(Var::Type::UNDEFINED, result.type());
+}
+
+TEST(Serialization, multipleRoots)
+{
+    const std::vector<Var> expressions { a*b, a + b + c, sin(a*b), 42 };
+    bool success = false;
+    const std::string data(serialize(expressions));
+    const std::vector<Var> result(deserializeAll(data.data(), data.size(), &success));
+
+    CHECK(success);
+    CHECK_EQUAL(expressions.size(), result.size());
+
+    for (size_t i = 0; i < result.size(); ++i)
+        CHECK_EQUAL(expressions[i], result[i]);
+}
+
+TEST(Serialization, identicalSubexpressionsAreWrittenOnce)
+{
+    const Var shared(sin(b + c)*pow(c, a));
+    const std::string once(serialize(shared));
+    const std::string twice(serialize(std::vector<Var>{ shared, a*shared }));
+    const std::vector<Var> result(deserializeAll(twice.data(), twice.size()));
+    size_t nSharedOperands = 0;
+
+    CHECK(twice.size() < 2*once.size());
+    CHECK_EQUAL(2, result.size());
+
+    for (const auto& operand : result[1].operands())
+        for (const auto& sharedOperand : result[0].operands())
+            if (address(operand) == address(sharedOperand))
+                ++nSharedOperands;
+
+    CHECK_EQUAL(2, nSharedOperands);
+}
+
+TEST(Serialization, loadingDoesntSimplifyAgain)
+    /* The nodes of a + b are a, b and the sum. Then, the trailing bytes are the operand indices
+     * 0 and 1 of the sum, one root and its index. The second sum operand is changed to refer to a,
+     * and the resulting a + a must not be simplified to 2*a. */
+{
+    std::string data(serialize(a + b));
+    Var result;
+
+    data[data.size() - 12] = 0;
+
+    result = deserialize(data);
+
+    CHECK_EQUAL(Var::Type::SUM, result.type());
+    CHECK_EQUAL(2, result.operands().size());
+    CHECK_EQUAL(a, result.operands().front());
+    CHECK_EQUAL(a, result.operands().back());
+}
+
+TEST(Serialization, saveAndLoadFile)
+{
+    const std::vector<Var> expressions { a*b*c, sqrt(a + 2)/(b - c), Var(1, 3) };
+    bool success = false;
+
+    CHECK(saveBinary(filename, expressions));
+
+    const std::vector<Var> result(loadBinary(filename, &success));
+
+    CHECK(success);
+    CHECK_EQUAL(expressions.size(), result.size());
+
+    for (size_t i = 0; i < result.size(); ++i)
+        CHECK_EQUAL(expressions[i], result[i]);
+}
+
+TEST(Serialization, loadNonExistingFile)
+{
+    bool success = true;
+
+    disableLog();
+    const std::vector<Var> result(loadBinary("misc/test-logfiles/non-existing-file.bin", &success));
+    enableLog();
+
+    CHECK_FALSE(success);
+    CHECK(result.empty());
+}
+
+TEST(Serialization, wrongMagicBytes)
+{
+    std::string data(serialize(a));
+    bool success = true;
+
+    data[0] = 'x';
+
+    disableLog();
+    const Var result(deserialize(data, &success));
+    enableLog();
+
+    CHECK_FALSE(success);
+    CHECK_EQUAL(Var::Type::UNDEFINED, result.type());
+}
+
+TEST(Serialization, wrongVersion)
+{
+    std::string data(serialize(a));
+    bool success = true;
+
+    data[sizeof(dagFormat::magic)] = static_cast<char>(dagFormat::version + 1);
+
+    disableLog();
+    deserialize(data, &success);
+    enableLog();
+
+    CHECK_FALSE(success);
+}
+
+TEST(Serialization, truncatedData)
+{
+    const std::string data(serialize(a*b + sin(c)));
+    bool success = true;
+
+    disableLog();
+    for (size_t length = 0; length < data.size(); ++length) {
+        success = true;
+        CHECK(deserializeAll(data.data(), length, &success).empty());
+        CHECK_FALSE(success);
+    }
+    enableLog();
+}
+
+TEST(Serialization, invalidNodeIndex)
+{
+    std::string data(serialize(a*b));
+    bool success = true;
+
+    /* The last four bytes are the root index, which is made to refer to a non-existing node: */
+    data[data.size() - 4] = 10;
+
+    disableLog();
+    deserialize(data, &success);
+    enableLog();
+
+    CHECK_FALSE(success);
+}
+
+TEST(Serialization, temporarySymbolsAreWrittenAsUndefined)
+{
+    const Var tmp(Symbol::createTmpSymbol());
+    bool success = false;
+
+    disableLog();
+    const Var result(deserialize(serialize(tmp), &success));
+    enableLog();
+
+    CHECK(success);
+    CHECK_EQUAL(Var::Type::UNDEFINED, result.type());
+}
@@ -0,0 +1,195 @@
+
+#include "abc.h"
+#include "sparsepoly.h"
+#include "sum.h"
+#include "product.h"
+#include "power.h"
+#include "trigonometric.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(SparsePoly)
+{
+    BasePtrList vars;
+
+    void setup()
+    {
+        vars = BasePtrList{ a, b, c };
+    }
+
+    SparsePoly convert(const BasePtr& ptr)
+    {
+        SparsePoly result;
+
+        CHECK(SparsePoly::fromBasePtr(ptr, vars, result));
+
+        return result;
+    }
+};
+
+TEST(SparsePoly, zero)
+{
+    const SparsePoly poly(convert(zero));
+
+    CHECK(poly.isZero());
+    CHECK(poly.isConstant());
+    CHECK_EQUAL(0, poly.degree(0));
+    CHECK_EQUAL(zero, poly.toBasePtr(vars));
+}
+
+TEST(SparsePoly, constant)
+{
+    const SparsePoly poly(convert(Numeric::create(-2, 3)));
+
+    CHECK(poly.isConstant());
+    CHECK_EQUAL(Number(-2, 3), poly.constant());
+    CHECK_EQUAL(Numeric::create(-2, 3), poly.toBasePtr(vars));
+}
+
+TEST(SparsePoly, conversionEqualsExpansion)
+{
+    const BasePtr ptr = Product::create(Power::create(Sum::create(a, two, b), three),
+            Sum::create(c, Product::create(Numeric::create(1, 2), a)));
+    const SparsePoly poly(convert(ptr));
+
+    CHECK_EQUAL(ptr->expand(), poly.toBasePtr(vars));
+}
+
+TEST(SparsePoly, termOrder)
+{
+    const SparsePoly poly(convert(Sum::create(b, Power::create(a, two), Product::create(a, c))));
+    const auto& terms(poly.terms());
+
+    CHECK_EQUAL(3, terms.size());
+    CHECK((SparsePoly::Exponents{ 2, 0, 0 }) == terms[0].exp);
+    CHECK((SparsePoly::Exponents{ 1, 0, 1 }) == terms[1].exp);
+    CHECK((SparsePoly::Exponents{ 0, 1, 0 }) == terms[2].exp);
+}
+
+TEST(SparsePoly, constructionFromUnsortedTerms)
+{
+    const std::vector<SparsePoly::Term> terms { { { 0, 1, 0 }, 2 }, { { 1, 0, 0 }, -1 },
+        { { 0, 1, 0 }, -2 }, { { 1, 0, 0 }, 3 }, { { 0, 0, 0 }, 0 } };
+    const SparsePoly poly(3, terms);
+
+    CHECK_EQUAL(1, poly.terms().size());
+    CHECK_EQUAL(Product::create(two, a), poly.toBasePtr(vars));
+}
+
+TEST(SparsePoly, conversionWithNumericPowerAsVariable)
+    /* sqrt(2)^2 + sqrt(2)*a + a = 2 + (1 + sqrt(2))*a. */
+{
+    const BasePtr sqrtTwo = Power::sqrt(two);
+    const std::vector<SparsePoly::Term> terms { { { 2, 0 }, 1 }, { { 1, 1 }, 1 },
+        { { 0, 1 }, 1 } };
+    const SparsePoly poly(2, terms);
+    const BasePtr expected = Sum::create(two, Product::create(sqrtTwo, a), a);
+
+    CHECK_EQUAL(expected, poly.toBasePtr(BasePtrList{ sqrtTwo, a }));
+}
+
+TEST(SparsePoly, invalidInput)
+{
+    SparsePoly poly;
+
+    CHECK_FALSE(SparsePoly::fromBasePtr(Trigonometric::createSin(a), vars, poly));
+    CHECK_FALSE(SparsePoly::fromBasePtr(Power::oneOver(a), vars, poly));
+    CHECK_FALSE(SparsePoly::fromBasePtr(Sum::create(a, d), vars, poly));
+    CHECK_FALSE(SparsePoly::fromBasePtr(Numeric::create(1.23456789), vars, poly));
+}
+
+TEST(SparsePoly, cancellation)
+{
+    const SparsePoly p1(convert(Sum::create(a, b)));
+    const SparsePoly p2(convert(Sum::create(a, Product::minus(b))));
+
+    CHECK(convert(Product::create(two, a)) == p1 + p2);
+    CHECK(convert(Product::create(two, b)) == p1 - p2);
+    CHECK((p1 - p1).isZero());
+    CHECK(convert(Sum::create(Power::create(a, two), Product::minus(b, b))) == p1*p2);
+}
+
+TEST(SparsePoly, degreeAndCoeff)
+{
+    const BasePtr ptr = Sum::create(Product::create(three, Power::create(a, four), b),
+            Product::create(Power::create(a, four), c), Product::create(a, a, b));
+    const SparsePoly poly(convert(ptr));
+
+    CHECK_EQUAL(4, poly.degree(0));
+    CHECK_EQUAL(2, poly.minDegree(0));
+    CHECK_EQUAL(1, poly.degree(1));
+    CHECK(convert(Sum::create(Product::create(three, b), c)) == poly.leadingCoeff(0));
+    CHECK(convert(b) == poly.coeff(0, 2));
+    CHECK(poly.coeff(0, 3).isZero());
+}
+
+TEST(SparsePoly, divideWithRemainder)
+    /* (3*a^3 - 5*a^2 + 10*a - 3)/(3a + 1): quotient a^2 - 2a + 4, remainder -7. */
+{
+    const SparsePoly u(convert(Sum::create({ Product::create(three, Power::create(a, three)),
+                    Product::create(Numeric::create(-5), Power::create(a, two)),
+                    Product::create(ten, a), Numeric::create(-3) })));
+    const SparsePoly v(convert(Sum::create(Product::create(three, a), one)));
+    SparsePoly quotient;
+    SparsePoly remainder;
+
+    u.divide(v, 0, 1, quotient, remainder);
+
+    CHECK(convert(Sum::create(Power::create(a, two), Product::minus(two, a), four)) == quotient);
+    CHECK(SparsePoly(3, -7) == remainder);
+}
+
+TEST(SparsePoly, divideMultivariate)
+{
+    const SparsePoly p1(convert(Sum::create(Product::create(a, b), Power::create(c, three))));
+    const SparsePoly p2(convert(Sum::create(Product::create(two, a), Product::minus(b, c), one)));
+    SparsePoly quotient;
+    SparsePoly remainder;
+
+    (p1*p2).divide(p2, 0, 3, quotient, remainder);
+
+    CHECK(p1 == quotient);
+    CHECK(remainder.isZero());
+}
+
+TEST(SparsePoly, divideWithoutVariables)
+{
+    const SparsePoly u(convert(Sum::create(Product::create(four, a), Product::create(six, b))));
+    const SparsePoly v(convert(Sum::create(Product::create(two, a), Product::create(three, b))));
+    SparsePoly quotient;
+    SparsePoly remainder;
+
+    u.divide(v, 0, 0, quotient, remainder);
+
+    CHECK(SparsePoly(3, 2) == quotient);
+    CHECK(remainder.isZero());
+
+    v.divide(convert(a), 0, 0, quotient, remainder);
+
+    CHECK(quotient.isZero());
+    CHECK(v == remainder);
+}
+
+TEST(SparsePoly, pseudoDivide)
+    /* Example from Cohen [2003] for u = 5*a^4*b^3 + 3*a*b + 2 and v = 2*a^3*b + 2*a + 3. */
+{
+    const SparsePoly u(convert(Sum::create(
+                    Product::create(five, Power::create(a, four), Power::create(b, three)),
+                    Product::create(three, a, b), two)));
+    const SparsePoly v(convert(Sum::create(Product::create(two, Power::create(a, three), b),
+                    Product::create(two, a), three)));
+    const SparsePoly expected(convert(Sum::create(
+                    Product::create(Numeric::create(-20), a, a, Power::create(b, four)),
+                    Product::create(Numeric::create(-30), a, Power::create(b, four)),
+                    Product::create(Numeric::create(12), a, Power::create(b, three)),
+                    Product::create(eight, b, b))));
+    SparsePoly quotient;
+    SparsePoly remainder;
+
+    u.pseudoDivide(v, 0, quotient, remainder);
+
+    CHECK(convert(Product::create(ten, a, Power::create(b, four))) == quotient);
+    CHECK(expected == remainder);
+    CHECK(expected == u.pseudoRemainder(v, 0));
+}
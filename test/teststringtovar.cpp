@@ -1,6 +1,8 @@
 
 #include <cassert>
 #include <limits>
+#include <thread>
+#include <string>
 #include "stringtovar.h"
 #include "globals.h"
 #include "sum.h"
@@ -756,3 +758,99 @@ TEST(StringToVar, eulerInMixedTerm)
 
     checkSuccess(expected, stv);
 }
+
+TEST(StringToVar, longSumChain)
+{
+    const size_t nSummands = 200;
+    std::string source("a");
+    Var expected(a);
+
+    for (size_t i = 1; i < nSummands; ++i) {
+        const std::string name("s_{" + std::to_string(i) + "}");
+
+        source += (i % 3 == 0 ? " - " : " + ") + std::to_string(i) + "*" + name;
+        expected += (i % 3 == 0 ? -1 : 1)*static_cast<int>(i)*Var(name.c_str());
+    }
+
+    const StringToVar stv(source);
+
+    checkSuccess(expected, stv);
+}
+
+TEST(StringToVar, longProductChainWithQuotients)
+{
+    const StringToVar stv("2*a*b/c*d*a/(b*3)*c^2/d/a");
+    const Var expected = Var(2, 3)*a*c;
+
+    checkSuccess(expected, stv);
+}
+
+TEST(StringToVar, nestedSumsAndProducts)
+{
+    const StringToVar stv("a - (b - c) + (d + a)*(b*(c*d)) - -(a + b)*c/(d + c)");
+    const Var expected = a - (b - c) + (d + a)*(b*(c*d)) - -(a + b)*c/(d + c);
+
+    checkSuccess(expected, stv);
+}
+
+TEST(StringToVar, unaryMinusOfProduct)
+{
+    const StringToVar stv("-a*b*c - -2*b*c");
+    const Var expected = -a*b*c + 2*b*c;
+
+    checkSuccess(expected, stv);
+}
+
+TEST(StringToVar, parallelParsing)
+{
+    const std::vector<std::string> sources { "a*b + 2*sin(c)", "1/2*sqrt(2)*a^2",
+        "(a + b)*atan2(c, d)", "10*Euler - a*log(euler)" };
+    const std::vector<Var> expected { a*b + 2*sin(c), Var(1, 2)*sqrt(Var(2))*a*a,
+        (a + b)*atan2(c, d), 10*Euler - a };
+    std::vector<std::vector<StringToVar*>> results(sources.size());
+    std::vector<std::thread> threads;
+    const size_t nRuns = 50;
+
+    for (size_t i = 0; i < sources.size(); ++i)
+        threads.push_back(std::thread([&sources, &results, nRuns, i]() {
+                    for (size_t j = 0; j < nRuns; ++j)
+                        results[i].push_back(new StringToVar(sources[i]));
+                    }));
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < sources.size(); ++i)
+        for (const auto *stv : results[i]) {
+            checkSuccess(expected[i], *stv);
+            delete stv;
+        }
+}
+
+TEST(StringToVar, parallelParsingWithErrors)
+{
+    const std::vector<std::string> sources { "a*(b + c", "2*sin(a", "a + b)*c", "a^^2" };
+    std::vector<std::vector<bool>> success(sources.size());
+    std::vector<std::thread> threads;
+    const size_t nRuns = 50;
+
+    disableLog();
+
+    for (size_t i = 0; i < sources.size(); ++i)
+        threads.push_back(std::thread([&sources, &success, nRuns, i]() {
+                    for (size_t j = 0; j < nRuns; ++j)
+                        success[i].push_back(StringToVar(sources[i]).success());
+                    }));
+
+    for (auto& thread : threads)
+        thread.join();
+
+    enableLog();
+
+    for (const auto& flags : success) {
+        CHECK_EQUAL(nRuns, flags.size());
+
+        for (const bool flag : flags)
+            CHECK_FALSE(flag);
+    }
+}
@@ -536,3 +536,13 @@ TEST(Sum, nonContractableSinCosSquareNonEqualPrefactor)
     CHECK_EQUAL(s2, result->operands().front());
     CHECK_EQUAL(s1, result->operands().back());
 }
+
+TEST(Sum, collectionOfManyUnorderedSummands)
+    /* d + 2*a + (b + c) - c + a + 3 - d + 1 = 3*a + b + 4. */
+{
+    const BasePtr expected = Sum::create(Product::create(three, a), b, four);
+    const BasePtr res = Sum::create({ d, Product::create(two, a), Sum::create(b, c),
+            Product::minus(c), a, three, Product::minus(d), one });
+
+    CHECK_EQUAL(expected, res);
+}
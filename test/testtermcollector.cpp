@@ -0,0 +1,144 @@
+#include "abc.h"
+#include "termcollector.h"
+#include "sum.h"
+#include "product.h"
+#include "power.h"
+#include "trigonometric.h"
+#include "undefined.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(TermCollector)
+{
+    TermCollector collector;
+    BasePtr sqrtTwo;
+
+    void setup()
+    {
+        sqrtTwo = Power::sqrt(two);
+    }
+};
+
+TEST(TermCollector, emptyCollectorIsZero)
+{
+    CHECK_EQUAL(zero, collector.sum());
+}
+
+TEST(TermCollector, singleTerm)
+{
+    const BasePtr term = Product::create(three, a, b);
+
+    collector.add(term);
+
+    CHECK_EQUAL(term, collector.sum());
+}
+
+TEST(TermCollector, equalMonomials)
+    /* 2*a*b + 3*a*b + 4 + a*b - 1 = 6*a*b + 3. */
+{
+    const BasePtr ab = Product::create(a, b);
+
+    collector.add(Product::create(two, ab));
+    collector.add(Product::create(three, ab));
+    collector.add(four);
+    collector.add(ab);
+    collector.add(Numeric::mOne());
+
+    CHECK_EQUAL(Sum::create(Product::create(six, ab), three), collector.sum());
+}
+
+TEST(TermCollector, cancellationToZero)
+{
+    collector.add(Product::create(two, a, Power::create(b, two)));
+    collector.add(Product::minus(two, a, Power::create(b, two)));
+
+    CHECK_EQUAL(zero, collector.sum());
+}
+
+TEST(TermCollector, sumsAreAddedBySummand)
+    /* (a + b) + (a - b) + c = 2*a + c. */
+{
+    collector.add(Sum::create(a, b));
+    collector.add(Sum::create(a, Product::minus(b)));
+    collector.add(c);
+
+    CHECK_EQUAL(Sum::create(Product::create(two, a), c), collector.sum());
+}
+
+TEST(TermCollector, numericPowersAsCoefficients)
+    /* sqrt(2)*a + 2*sqrt(2)*a + a = (1 + 3*sqrt(2))*a, which is left to the simplification of the
+     * sum. */
+{
+    const BasePtr expected = Sum::create(Product::create(sqrtTwo, a),
+            Product::create(two, sqrtTwo, a), a);
+
+    collector.add(Product::create(sqrtTwo, a));
+    collector.add(Product::create(two, sqrtTwo, a));
+    collector.add(a);
+
+    CHECK_EQUAL(expected, collector.sum());
+}
+
+TEST(TermCollector, contractableSinCos)
+{
+    collector.add(Power::create(Trigonometric::createSin(a), two));
+    collector.add(Power::create(Trigonometric::createCos(a), two));
+
+    CHECK_EQUAL(one, collector.sum());
+}
+
+TEST(TermCollector, undefinedTerm)
+{
+    collector.add(a);
+    collector.add(Undefined::create());
+
+    CHECK(collector.sum()->isUndefined());
+}
+
+TEST(TermCollector, sameResultAsSumCreation)
+{
+    const BasePtrList summands{ Product::create(five, c, d), Power::create(a, three), b,
+        Product::create(sqrtTwo, b), Product::minus(a, d), Product::create(seven, a, d), ten,
+        Product::create(Numeric::create(1, 3), Power::create(c, four), a) };
+
+    for (const auto& summand : summands)
+        collector.add(summand);
+
+    CHECK_EQUAL(Sum::create(summands), collector.sum());
+}
+
+TEST(TermCollector, contractionWithOtherSummands)
+    /* sin(a)^2 + cos(a)^2 + 3 + b = 4 + b. */
+{
+    collector.add(Power::create(Trigonometric::createSin(a), two));
+    collector.add(Power::create(Trigonometric::createCos(a), two));
+    collector.add(three);
+    collector.add(b);
+
+    CHECK_EQUAL(Sum::create(four, b), collector.sum());
+}
+
+TEST(TermCollector, numericPowersBetweenOtherSummands)
+{
+    const BasePtrList summands{ d, Product::create(sqrtTwo, c), b, Product::create(sqrtTwo, a) };
+
+    for (const auto& summand : summands)
+        collector.add(summand);
+
+    CHECK_EQUAL(Sum::create(summands), collector.sum());
+}
+
+TEST(TermCollector, mergeOfTwoCollectors)
+{
+    TermCollector other;
+
+    collector.add(Product::create(two, a));
+    collector.add(b);
+    other.add(Product::minus(a));
+    other.add(Product::create(sqrtTwo, c));
+
+    collector.merge(other);
+
+    CHECK_EQUAL(Sum::create(a, b, Product::create(sqrtTwo, c)), collector.sum());
+}
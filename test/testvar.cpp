@@ -1,5 +1,6 @@
 
 #include <sstream>
+#include <iomanip>
 #include <limits>
 #include <algorithm>
 #include "number.h"
@@ -976,6 +977,33 @@ TEST(Var, normalToZero)
     CHECK(sum.normal().isZero());
 }
 
+TEST(Var, zeroTestOfRationalExpressions)
+{
+    const Var zero = (a*a - b*b)/(a - b) - a - b;
+    const Var nonZero = (a*a - b*b)/(a + b) - a - b;
+
+    CHECK(zero.isZeroProbabilistic());
+    CHECK_FALSE(nonZero.isZeroProbabilistic());
+}
+
+TEST(Var, zeroTestOfLargeCoefficients)
+{
+    const Var coeff("4611685975477714963");
+    const Var sum = coeff*a + coeff*b;
+
+    CHECK_FALSE(sum.isZeroProbabilistic());
+    CHECK_FALSE(sum.normal().isZero());
+}
+
+TEST(Var, zeroTestWithFunctionsFallsBackToNormal)
+{
+    const Var zero = tan(a)*cos(a) - sin(a);
+    const Var nonZero = tan(a)*cos(a) - sin(b);
+
+    CHECK(zero.isZeroProbabilistic());
+    CHECK_FALSE(nonZero.isZeroProbabilistic());
+}
+
 TEST(Var, getNumAndDenomFromFraction)
 {
     const Var frac(2, 3);
@@ -1071,6 +1099,18 @@ TEST(Var, printerOperator)
     CHECK_EQUAL(expected, stream.str());
 }
 
+TEST(Var, printerOperatorWithStreamFormatting)
+    /* The width only applies to the first insertion. */
+{
+    const std::string expected("..a*b|a + b  |c");
+    std::stringstream stream;
+
+    stream << std::setfill('.') << std::setw(5) << a*b << "|";
+    stream << std::left << std::setfill(' ') << std::setw(7) << a + b << "|" << c;
+
+    CHECK_EQUAL(expected, stream.str());
+}
+
 TEST(Var, printerOperatorTypeEnumSumProductPower)
 {
     const std::string expected("SumProductPower");
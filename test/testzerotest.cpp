@@ -0,0 +1,151 @@
+#include "abc.h"
+#include "zerotest.h"
+#include "sum.h"
+#include "product.h"
+#include "power.h"
+#include "trigonometric.h"
+#include "tsymtests.h"
+
+using namespace tsym;
+
+TEST_GROUP(ZeroTest)
+{
+    std::mt19937_64 generator;
+
+    ZeroTest::Result result(const BasePtr& expr)
+    {
+        ZeroTest test(1e-12, generator);
+
+        return test.test(expr);
+    }
+};
+
+TEST(ZeroTest, zeroNumber)
+{
+    CHECK(ZeroTest::Result::ZERO == result(zero));
+}
+
+TEST(ZeroTest, nonZeroNumbers)
+{
+    CHECK(ZeroTest::Result::NONZERO == result(two));
+    CHECK(ZeroTest::Result::NONZERO == result(Numeric::create(-2, 3)));
+    CHECK(ZeroTest::Result::NONZERO == result(a));
+}
+
+TEST(ZeroTest, binomialFormula)
+    /* (a + b)^2 - a^2 - 2*a*b - b^2. */
+{
+    const BasePtr orig = Sum::create(Power::create(Sum::create(a, b), two),
+            Product::minus(Power::create(a, two)), Product::minus(two, a, b),
+            Product::minus(Power::create(b, two)));
+
+    CHECK(ZeroTest::Result::ZERO == result(orig));
+}
+
+TEST(ZeroTest, incompleteBinomialFormula)
+    /* (a + b)^2 - a^2 - b^2. */
+{
+    const BasePtr orig = Sum::create(Power::create(Sum::create(a, b), two),
+            Product::minus(Power::create(a, two)), Product::minus(Power::create(b, two)));
+
+    CHECK(ZeroTest::Result::NONZERO == result(orig));
+}
+
+TEST(ZeroTest, highPowerMinusItsExpansion)
+{
+    const BasePtr pow = Power::create(Sum::create(a, Product::create(two, b), c),
+            Numeric::create(30));
+    const BasePtr orig = Sum::create(pow, Product::minus(pow->expand()));
+
+    CHECK(ZeroTest::Result::ZERO == result(orig));
+}
+
+TEST(ZeroTest, rationalFunction)
+    /* (a^2 - 1)/(a - 1) - a - 1 + b/c - b^2/(b*c). */
+{
+    const BasePtr orig = Sum::create(Product::create(Sum::create(Power::create(a, two),
+                    Numeric::mOne()), Power::oneOver(Sum::create(a, Numeric::mOne()))),
+            Product::minus(a), Numeric::mOne(), Sum::create(Product::create(b,
+                    Power::oneOver(c)), Product::minus(Power::create(b, two),
+                    Power::oneOver(Product::create(b, c)))));
+
+    CHECK(ZeroTest::Result::ZERO == result(orig));
+}
+
+TEST(ZeroTest, nonZeroRationalFunction)
+{
+    const BasePtr orig = Sum::create(Product::create(a, Power::oneOver(b)),
+            Product::minus(b, Power::oneOver(a)));
+
+    CHECK(ZeroTest::Result::NONZERO == result(orig));
+}
+
+TEST(ZeroTest, smallErrorBound)
+{
+    const BasePtr orig = Sum::create(Power::create(Sum::create(a, b), two),
+            Product::minus(Sum::create(a, b), Sum::create(b, a)));
+    ZeroTest strict(1e-200, generator);
+
+    CHECK(ZeroTest::Result::ZERO == strict.test(orig));
+}
+
+TEST(ZeroTest, functionIsInconclusive)
+{
+    const BasePtr orig = Sum::create(Trigonometric::createSin(a), Product::minus(b));
+
+    CHECK(ZeroTest::Result::INCONCLUSIVE == result(orig));
+}
+
+TEST(ZeroTest, numericPowerIsInconclusive)
+{
+    const BasePtr orig = Sum::create(Product::create(Power::sqrt(two), a), b);
+
+    CHECK(ZeroTest::Result::INCONCLUSIVE == result(orig));
+}
+
+TEST(ZeroTest, symbolicExponentIsInconclusive)
+{
+    CHECK(ZeroTest::Result::INCONCLUSIVE == result(Power::create(a, b)));
+}
+
+TEST(ZeroTest, doubleIsInconclusive)
+{
+    const BasePtr orig = Sum::create(Product::create(Numeric::create(1.23456), a), b);
+
+    CHECK(ZeroTest::Result::INCONCLUSIVE == result(orig));
+}
+
+TEST(ZeroTest, degreeTooLargeIsInconclusive)
+    /* (a^2 - 1)^n - ((a + 1)*(a - 1))^n for n = 2^40. */
+{
+    const BasePtr n = Numeric::create(Int(2).toThe(40));
+    const BasePtr aMinusOne = Sum::create(a, Numeric::mOne());
+    const BasePtr orig = Sum::create(Power::create(Sum::create(Power::create(a, two),
+                    Numeric::mOne()), n), Product::minus(Power::create(Product::create(
+                        Sum::create(a, one), aMinusOne), n)));
+
+    CHECK(ZeroTest::Result::INCONCLUSIVE == result(orig));
+}
+
+TEST(ZeroTest, coefficientDivisibleByLargePrimes)
+    /* The coefficient is the product of the two largest primes below 2^31. */
+{
+    const BasePtr coeff = Numeric::create(Int("4611685975477714963"));
+    const BasePtr orig = Sum::create(Product::create(coeff, a), Product::create(coeff, b));
+
+    CHECK(ZeroTest::Result::NONZERO == result(Product::create(coeff, a)));
+    CHECK(ZeroTest::Result::NONZERO == result(orig));
+    CHECK_EQUAL(orig, orig->normal());
+}
+
+TEST(ZeroTest, coefficientDivisibleAfterExpansion)
+    /* (a + 1)*c1 - a*c2 - c1 with c1 - c2 = 2147483647*2147483629, where neither number is
+     * divisible by one of the primes. */
+{
+    const Int c2("1000000000000000001");
+    const BasePtr c1 = Numeric::create(c2 + Int("4611685975477714963"));
+    const BasePtr orig = Sum::create(Product::create(Sum::create(a, one), c1),
+            Product::minus(a, Numeric::create(c2)), Product::minus(c1));
+
+    CHECK(ZeroTest::Result::NONZERO == result(orig));
+}